@@ -144,8 +144,8 @@ struct alias_static_storage
     // class on types that are empty with constructors that have no possible
     // side effects.
     static_assert(std::is_empty<T>::value && 
-        std::is_literal_type<T>::value && 
-        std::is_default_constructible<T>::value, "In-class initialization is not yet implemented on MSVC");
+        std::is_default_constructible<T>::value &&
+        detail::is_constexpr_default_constructible<T>::value, "In-class initialization is not yet implemented on MSVC");
 #endif
     static constexpr T value = T();
 };
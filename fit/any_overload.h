@@ -0,0 +1,245 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    any_overload.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_ANY_OVERLOAD_H
+#define FIT_GUARD_ANY_OVERLOAD_H
+
+/// any_overload
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `any_overload` class is an owning, type-erased function object that
+/// can be called with several signatures, such as an overload set built with
+/// `match`. The function is stored once, either inline or on the heap if it
+/// is too large, along with a single table of functions to call it for each
+/// signature. So each call is only one indirect call, rather than storing a
+/// separate `std::function` for each signature. Overload resolution between
+/// the signatures is done the same way as for regular overloaded functions.
+///
+/// Like `unique_function`, the function only needs to be move constructible,
+/// and `any_overload` itself is move-only.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Signatures>
+///     class any_overload
+///     {
+///         any_overload();
+///         template<class F>
+///         any_overload(F f);
+///         any_overload(any_overload&&) noexcept;
+///
+///         // For each signature R(Ts...)
+///         R operator()(Ts... xs) const;
+///         explicit operator bool() const;
+///     };
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     fit::any_overload<int(int), int(const std::string&)> f = fit::match(
+///         [](int x) { return x; },
+///         [](const std::string& s) { return int(s.size()); }
+///     );
+///     assert(f(3) == 3);
+///     assert(f(std::string("hello")) == 5);
+///
+
+#include <fit/unique_function.h>
+#include <fit/detail/and.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class... Sigs>
+struct any_overload_vtable
+{
+    typedef std::allocator<char> allocator_type;
+    void (*move)(void*, void*);
+    void (*destroy)(void*, allocator_type&);
+    void (*invoke[sizeof...(Sigs)])();
+};
+
+template<class F, class Sig>
+struct any_overload_invoke;
+
+template<class F, class R, class... Ts>
+struct any_overload_invoke<F, R(Ts...)>
+{
+    typedef unique_function_manager<F, is_inline_storable<F>::value> manager;
+
+    static R call(const void* p, Ts... xs)
+    {
+        return function_ref_invoke<R>::call(manager::get(p), fit::forward<Ts>(xs)...);
+    }
+};
+
+template<class F, class Sig>
+struct any_overload_is_callable;
+
+template<class F, class R, class... Ts>
+struct any_overload_is_callable<F, R(Ts...)>
+: is_callable<const F&, Ts...>
+{};
+
+template<class F, class... Sigs>
+struct any_overload_vtable_for
+{
+    typedef unique_function_manager<F, is_inline_storable<F>::value> manager;
+    static const any_overload_vtable<Sigs...> value;
+};
+
+template<class F, class... Sigs>
+const any_overload_vtable<Sigs...> any_overload_vtable_for<F, Sigs...>::value =
+{
+    &manager::move,
+    &manager::template destroy<std::allocator<char>>,
+    { reinterpret_cast<void (*)()>(&any_overload_invoke<F, Sigs>::call)... }
+};
+
+template<class Derived, int N, class... Sigs>
+struct any_overload_base;
+
+template<class Derived, int N, class R, class... Ts>
+struct any_overload_base<Derived, N, R(Ts...)>
+{
+    R operator()(Ts... xs) const
+    {
+        return static_cast<const Derived&>(*this).template invoke<N, R, Ts...>(fit::forward<Ts>(xs)...);
+    }
+};
+
+template<class Derived, int N, class R, class... Ts, class Sig, class... Sigs>
+struct any_overload_base<Derived, N, R(Ts...), Sig, Sigs...>
+: any_overload_base<Derived, N+1, Sig, Sigs...>
+{
+    typedef any_overload_base<Derived, N+1, Sig, Sigs...> base;
+    using base::operator();
+
+    R operator()(Ts... xs) const
+    {
+        return static_cast<const Derived&>(*this).template invoke<N, R, Ts...>(fit::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+template<class... Sigs>
+class any_overload;
+
+namespace detail {
+
+template<class T>
+struct is_any_overload
+: std::false_type
+{};
+
+template<class... Sigs>
+struct is_any_overload<any_overload<Sigs...>>
+: std::true_type
+{};
+
+}
+
+template<class... Sigs>
+class any_overload
+: public detail::any_overload_base<any_overload<Sigs...>, 0, Sigs...>
+{
+    template<class, int, class...>
+    friend struct detail::any_overload_base;
+
+    typedef detail::any_overload_vtable<Sigs...> vtable_type;
+    typename detail::unique_function_buffer<3*sizeof(void*)>::type buffer;
+    const vtable_type* vtable;
+
+    void reset()
+    {
+        std::allocator<char> a;
+        if (vtable != nullptr) vtable->destroy(&buffer, a);
+        vtable = nullptr;
+    }
+
+    template<int N, class R, class... Ts>
+    R invoke(Ts... xs) const
+    {
+        typedef R (*function_pointer)(const void*, Ts...);
+        if (vtable == nullptr) throw std::bad_function_call();
+        return reinterpret_cast<function_pointer>(vtable->invoke[N])(&buffer, fit::forward<Ts>(xs)...);
+    }
+public:
+    any_overload() : vtable(nullptr)
+    {}
+
+    any_overload(std::nullptr_t) : vtable(nullptr)
+    {}
+
+    template<class F, class D=typename std::decay<F>::type, typename std::enable_if<(
+        !detail::is_any_overload<D>::value &&
+        !std::is_same<D, std::nullptr_t>::value &&
+        detail::and_<detail::any_overload_is_callable<D, Sigs>...>::value
+    ), int>::type = 0>
+    any_overload(F&& f)
+    : vtable(&detail::any_overload_vtable_for<D, Sigs...>::value)
+    {
+        std::allocator<char> a;
+        detail::any_overload_vtable_for<D, Sigs...>::manager::create(&buffer, a, fit::forward<F>(f));
+    }
+
+    any_overload(any_overload&& rhs) noexcept
+    : vtable(rhs.vtable)
+    {
+        if (vtable != nullptr) vtable->move(&buffer, &rhs.buffer);
+        rhs.vtable = nullptr;
+    }
+
+    any_overload& operator=(any_overload&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            this->reset();
+            vtable = rhs.vtable;
+            if (vtable != nullptr) vtable->move(&buffer, &rhs.buffer);
+            rhs.vtable = nullptr;
+        }
+        return *this;
+    }
+
+    any_overload& operator=(std::nullptr_t)
+    {
+        this->reset();
+        return *this;
+    }
+
+    any_overload(const any_overload&) = delete;
+    any_overload& operator=(const any_overload&) = delete;
+
+    ~any_overload()
+    {
+        this->reset();
+    }
+
+    explicit operator bool() const
+    {
+        return vtable != nullptr;
+    }
+};
+
+}
+
+#endif
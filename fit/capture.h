@@ -25,6 +25,12 @@
 /// C++. It provides a way to do move and perfect capturing. The values
 /// captured are prepended to the argument list of the function that will be
 /// called.
+///
+/// The closure keeps its captured values, so it can be called more than once.
+/// For each call, a captured value that can be copied is copied, and the copy
+/// is passed to the function as an rvalue, so the function can move from it.
+/// A captured value that can only be moved is passed as a const lvalue.
+/// Captured references are passed as they were captured.
 /// 
 /// Synopsis
 /// --------
@@ -61,6 +67,27 @@ namespace fit {
 
 namespace detail {
 
+// Captured values are copied rather than moved, since the call operator is
+// const, and values that can't be copied are passed as const lvalues
+template<class T>
+struct capture_value
+: std::conditional<std::is_reference<T>::value, 
+    T&&,
+    typename std::conditional<std::is_copy_constructible<T>::value, T, const T&>::type
+>
+{};
+
+struct capture_forward_pack_f
+{
+    template<int... Ns, class... Ts>
+    constexpr auto operator()(const pack_base<seq<Ns...>, Ts...>& p) const FIT_RETURNS
+    (
+        pack_base<seq<Ns...>, typename capture_value<Ts>::type...>(
+            (typename capture_value<Ts>::type)(alias_value<pack_tag<seq<Ns>, Ts...>, Ts>(p, p))...
+        )
+    );
+};
+
 template<class F, class Pack>
 struct capture_invoke : F, Pack
 {
@@ -112,7 +139,7 @@ struct capture_invoke : F, Pack
     constexpr FIT_SFINAE_RESULT
     (
         typename result_of<decltype(fit::pack_join), 
-            id_<const Pack&>, 
+            result_of<capture_forward_pack_f, id_<const Pack&>>, 
             result_of<decltype(fit::pack_forward), id_<Ts>...> 
         >::type,
         id_<F&&>
@@ -121,7 +148,7 @@ struct capture_invoke : F, Pack
     (
         fit::pack_join
         (
-            FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(xs...)), 
+            capture_forward_pack_f()(FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(xs...))), 
             fit::pack_forward(fit::forward<Ts>(xs)...)
         )
         (FIT_RETURNS_C_CAST(F&&)(FIT_CONST_THIS->base_function(xs...)))
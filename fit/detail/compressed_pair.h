@@ -37,8 +37,8 @@ template<int I, class T, class U>
 struct pair_holder_related
 : std::conditional<
         std::is_empty<T>::value && 
-        std::is_literal_type<T>::value && 
-        is_default_constructible<T>::value, 
+        is_default_constructible<T>::value &&
+        is_constexpr_default_constructible<T>::value, 
     alias_static<T, pair_tag<I, T, U>>,
     alias<T, pair_tag<I, T, U>>
 >
@@ -101,6 +101,20 @@ struct is_default_constructible
 #endif
 {};
 
+// Checks that T() is a constant expression, without std::is_literal_type,
+// which is deprecated in C++17
+template<class T, class=void>
+struct is_constexpr_default_constructible
+: std::false_type
+{};
+
+template<class T>
+struct is_constexpr_default_constructible<T, typename holder<
+    std::integral_constant<bool, (static_cast<void>(T()), true)>
+>::type>
+: std::is_trivially_destructible<T>
+{};
+
 template<class T, class... Xs>
 struct is_constructible
 : std::is_constructible<T, Xs...>
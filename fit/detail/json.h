@@ -0,0 +1,32 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    json.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DETAIL_JSON_H
+#define FIT_GUARD_DETAIL_JSON_H
+
+#include <ostream>
+
+namespace fit { namespace detail {
+
+// Writes the characters from first to last as a quoted JSON string
+inline void json_write_string(std::ostream& os, const char* first, const char* last)
+{
+    static const char hex[] = "0123456789abcdef";
+    os << '"';
+    for(; first != last; first++)
+    {
+        char c = *first;
+        if (c == '"' || c == '\\') os << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20) os << "\\u00" << hex[(c >> 4) & 0xf] << hex[c & 0xf];
+        else os << c;
+    }
+    os << '"';
+}
+
+}}
+
+#endif
@@ -43,6 +43,25 @@ constexpr const T& static_const_var()
 #endif
 #endif
 
+// Makes it an error for a variable to need a dynamic initializer, on
+// compilers that can check it. Variables that are already constexpr don't
+// need it.
+#ifndef FIT_CONSTINIT
+#if defined(__cpp_constinit)
+#define FIT_CONSTINIT constinit
+#elif defined(__clang__)
+#if __has_cpp_attribute(clang::require_constant_initialization)
+#define FIT_CONSTINIT [[clang::require_constant_initialization]]
+#else
+#define FIT_CONSTINIT
+#endif
+#elif defined(__GNUC__) && __GNUC__ >= 10
+#define FIT_CONSTINIT __constinit
+#else
+#define FIT_CONSTINIT
+#endif
+#endif
+
 #if FIT_NO_UNIQUE_STATIC_VAR
 #define FIT_DECLARE_STATIC_VAR(name, ...) static constexpr __VA_ARGS__ name = {}
 #else
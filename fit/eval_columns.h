@@ -0,0 +1,363 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    eval_columns.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_EVAL_COLUMNS_H
+#define FIT_GUARD_EVAL_COLUMNS_H
+
+/// eval_columns
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `eval_columns` function evaluates a placeholder expression, or any
+/// other expression built with `lazy`, over whole columns. The placeholders
+/// refer to the columns, so `_1` is the first column, `_2` the second, and so
+/// on. For every row `i`, the result of the expression is stored in
+/// `out[i]`. The columns can be any type with `data()` and `size()`, such as
+/// `std::vector` or `std::array`, and the number of rows is the smallest of
+/// their sizes.
+///
+/// The rows are evaluated in blocks of `FIT_EVAL_COLUMNS_BLOCK` rows. Within
+/// a block, the expression tree is walked from the top. If a subexpression
+/// can be called with the SIMD vector types from `simd`, it is evaluated
+/// with a single vector loop, so its temporaries stay in registers. Otherwise
+/// its children are evaluated into buffers the size of a block, which stay
+/// in the L1 cache. Then the function is applied over those buffers, using
+/// vectors if possible. Comparison and logical operators are never
+/// evaluated with vectors, since they would produce masks rather than
+/// `bool`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Expression, class Out, class... Columns>
+///     void eval_columns(const Expression& e, Out&& out, const Columns&... columns);
+///
+/// Requirements
+/// ------------
+///
+/// Expression must be:
+///
+///     FunctionObject
+///
+/// Example
+/// -------
+///
+///     std::vector<float> price = {1, 2, 3};
+///     std::vector<float> quantity = {4, 5, 6};
+///     std::vector<float> total(3);
+///     fit::eval_columns(fit::_1 * fit::_2, total, price, quantity);
+///     assert(total[2] == 18);
+///
+
+#include <cstddef>
+#include <functional>
+#include <tuple>
+#include <type_traits>
+#include <fit/args.h>
+#include <fit/lazy.h>
+#include <fit/placeholders.h>
+#include <fit/vectorize.h>
+#include <fit/detail/seq.h>
+
+#ifndef FIT_EVAL_COLUMNS_BLOCK
+#define FIT_EVAL_COLUMNS_BLOCK 256
+#endif
+
+namespace fit {
+
+namespace detail {
+
+template<class T>
+struct eval_columns_column
+{
+    typedef T element_type;
+    typedef typename simd<T>::type vector_type;
+    static constexpr bool is_vector = true;
+
+    const T* data;
+
+    const T& at(std::size_t i) const
+    {
+        return data[i];
+    }
+
+    vector_type load(std::size_t i) const
+    {
+        return vectorize_load<vector_type>(data + i);
+    }
+};
+
+template<class T>
+struct eval_columns_buffer
+{
+    typedef T element_type;
+    typedef typename simd<T>::type vector_type;
+    static constexpr bool is_vector = true;
+
+    T data[FIT_EVAL_COLUMNS_BLOCK];
+
+    const T& at(std::size_t i) const
+    {
+        return data[i];
+    }
+
+    vector_type load(std::size_t i) const
+    {
+        return vectorize_load<vector_type>(data + i);
+    }
+};
+
+template<class T>
+struct eval_columns_scalar
+{
+    typedef T element_type;
+    typedef const T& vector_type;
+    static constexpr bool is_vector = false;
+
+    const T& value;
+
+    const T& at(std::size_t) const
+    {
+        return value;
+    }
+
+    const T& load(std::size_t) const
+    {
+        return value;
+    }
+};
+
+template<class Out, class Operand>
+struct eval_columns_operand_ok
+: std::integral_constant<bool, !Operand::is_vector || (
+    is_simd_element<typename Operand::element_type>::value &&
+    simd<typename Operand::element_type>::lanes == simd<Out>::lanes
+)>
+{};
+
+template<class F, class Out, class Operands, class=void>
+struct eval_columns_is_simd_callable
+: std::false_type
+{};
+
+template<class F, class Out, class... Operands>
+struct eval_columns_is_simd_callable<F, Out, void(Operands...), typename holder<
+    decltype(std::declval<const F&>()(std::declval<typename Operands::vector_type>()...))
+>::type>
+: std::is_same<
+    typename std::decay<decltype(std::declval<const F&>()(std::declval<typename Operands::vector_type>()...))>::type,
+    typename simd<Out>::type
+>
+{};
+
+template<class F, class Out, class... Operands>
+struct eval_columns_can_simd
+: std::integral_constant<bool,
+    is_simd_element<Out>::value &&
+    and_<eval_columns_operand_ok<Out, Operands>...>::value &&
+    !simd_has_mask<F>::value &&
+    eval_columns_is_simd_callable<F, Out, void(Operands...)>::value
+>
+{};
+
+template<class F, class Out, class... Operands>
+void eval_columns_apply(std::false_type, const F& f, Out* out, std::size_t n, const Operands&... xs)
+{
+    for(std::size_t i = 0; i < n; i++) out[i] = f(xs.at(i)...);
+}
+
+template<class F, class Out, class... Operands>
+void eval_columns_apply(std::true_type, const F& f, Out* out, std::size_t n, const Operands&... xs)
+{
+    const std::size_t lanes = simd<Out>::lanes;
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes) vectorize_store(out + i, f(xs.load(i)...));
+    for(; i < n; i++) out[i] = f(xs.at(i)...);
+}
+
+template<class F, class Out, class... Operands>
+void eval_columns_apply(const F& f, Out* out, std::size_t n, const Operands&... xs)
+{
+    eval_columns_apply(
+        std::integral_constant<bool, eval_columns_can_simd<F, Out, Operands...>::value>(),
+        f, out, n, xs...
+    );
+}
+
+// Only split lazy expressions into blocks of temporaries when some of the
+// subexpressions could be vectorized
+template<class Out, class... Columns>
+struct eval_columns_can_split
+: std::integral_constant<bool,
+    is_simd_element<Out>::value &&
+    and_<is_simd_element<typename Columns::element_type>...>::value
+>
+{};
+
+template<class Node>
+struct eval_columns_is_invoker
+: std::false_type
+{};
+
+template<class F, class Pack>
+struct eval_columns_is_invoker<lazy_invoker<F, Pack>>
+: std::true_type
+{};
+
+// Only lazy expressions can be split into their operands
+template<class Node, class Out, class... Columns>
+struct eval_columns_split_tag
+: std::integral_constant<bool,
+    eval_columns_is_invoker<Node>::value &&
+    !eval_columns_can_simd<Node, Out, Columns...>::value &&
+    eval_columns_can_split<Out, Columns...>::value
+>
+{};
+
+template<class F, class Out, class... Columns>
+struct eval_columns_split;
+
+template<class Node, class Out, class... Columns>
+void eval_columns_node(std::false_type, const Node& node, Out* out, std::size_t n, const Columns&... columns)
+{
+    eval_columns_apply(node, out, n, columns...);
+}
+
+template<class F, class Pack, class Out, class... Columns>
+void eval_columns_node(std::true_type, const lazy_invoker<F, Pack>& node, Out* out, std::size_t n, const Columns&... columns)
+{
+    node.get_pack()(eval_columns_split<F, Out, Columns...>{
+        node.base_function(), out, n, std::tuple<const Columns&...>(columns...)
+    });
+}
+
+template<class Node, class Out, class... Columns>
+void eval_columns_node(const Node& node, Out* out, std::size_t n, const Columns&... columns)
+{
+    eval_columns_node(
+        std::integral_constant<bool, eval_columns_split_tag<Node, Out, Columns...>::value>(),
+        node, out, n, columns...
+    );
+}
+
+template<class T, class... Columns, typename std::enable_if<(std::is_placeholder<T>::value > 0), int>::type = 0>
+auto eval_columns_operand(const T&, std::size_t, const Columns&... columns)
+-> typename std::decay<decltype(get_args<std::is_placeholder<T>::value>(columns...))>::type
+{
+    return get_args<std::is_placeholder<T>::value>(columns...);
+}
+
+template<class T, class... Columns, class R=typename std::decay<
+    decltype(std::declval<const T&>()(std::declval<const Columns&>().at(0)...))
+>::type, typename std::enable_if<std::is_bind_expression<T>::value, int>::type = 0>
+eval_columns_buffer<R> eval_columns_operand(const T& x, std::size_t n, const Columns&... columns)
+{
+    eval_columns_buffer<R> result;
+    eval_columns_node(x, result.data, n, columns...);
+    return result;
+}
+
+template<class T, class... Columns>
+eval_columns_scalar<T> eval_columns_operand(const lazy_hoisted<T>& x, std::size_t, const Columns&...)
+{
+    return eval_columns_scalar<T>{x.value};
+}
+
+template<class T, class... Columns>
+eval_columns_scalar<T> eval_columns_operand(const std::reference_wrapper<T>& x, std::size_t, const Columns&...)
+{
+    return eval_columns_scalar<T>{x.get()};
+}
+
+template<class T, class... Columns, typename std::enable_if<(
+    std::is_placeholder<T>::value == 0 &&
+    !std::is_bind_expression<T>::value &&
+    !is_reference_wrapper<T>::value
+), int>::type = 0>
+eval_columns_scalar<T> eval_columns_operand(const T& x, std::size_t, const Columns&...)
+{
+    return eval_columns_scalar<T>{x};
+}
+
+template<class F, class Out, class... Columns>
+struct eval_columns_split
+{
+    const F& f;
+    Out* out;
+    std::size_t n;
+    std::tuple<const Columns&...> columns;
+
+    template<int... Ns, class... Ts>
+    void apply(seq<Ns...>, const Ts&... xs) const
+    {
+        eval_columns_apply(f, out, n, eval_columns_operand(xs, n, std::get<Ns>(columns)...)...);
+    }
+
+    template<class... Ts>
+    void operator()(const Ts&... xs) const
+    {
+        this->apply(typename gens<sizeof...(Columns)>::type(), xs...);
+    }
+};
+
+template<class T>
+struct eval_columns_expression
+{
+    typedef const T& type;
+
+    static const T& get(const T& x)
+    {
+        return x;
+    }
+};
+
+template<class T>
+struct eval_columns_expression<const T>
+: eval_columns_expression<T>
+{};
+
+template<int N>
+struct eval_columns_expression<placeholder<N>>
+{
+    typedef placeholder_transformer::transformer<placeholder<N>> type;
+
+    static type get(const placeholder<N>&)
+    {
+        return type();
+    }
+};
+
+template<class E, class Out, class... Ts>
+void eval_columns_block(const E& e, Out* out, std::size_t n, std::size_t block, const Ts*... columns)
+{
+    for(std::size_t i = 0; i < n; i += block)
+    {
+        eval_columns_node(e, out + i, (n - i < block ? n - i : block),
+            eval_columns_column<Ts>{columns + i}...);
+    }
+}
+
+}
+
+template<class Expression, class Out, class... Columns>
+void eval_columns(const Expression& e, Out&& out, const Columns&... columns)
+{
+    typedef detail::eval_columns_expression<Expression> expression;
+    detail::eval_columns_block(
+        static_cast<typename expression::type>(expression::get(e)),
+        out.data(),
+        detail::vectorize_min(out.size(), columns.size()...),
+        FIT_EVAL_COLUMNS_BLOCK,
+        columns.data()...
+    );
+}
+
+}
+
+#endif
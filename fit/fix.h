@@ -17,9 +17,10 @@
 /// The `fix` function adaptor implements a fixed-point combinator. This can be
 /// used to write recursive functions. 
 /// 
-/// Note: Compilers are too eager to instantiate templates when using
+/// Note: Older compilers are too eager to instantiate templates when using
 /// constexpr, which causes the compiler to reach its internal instantiation
-/// limit. So, unfortunately, `fix` cannot be used for `constexpr` functions.
+/// limit. So `fix` can only be used for `constexpr` functions on C++14
+/// compilers. This can be checked with `FIT_FIX_HAS_CONSTEXPR`.
 /// 
 /// Synopsis
 /// --------
@@ -51,8 +52,12 @@
 #include <fit/detail/static_const_var.h>
 
 #ifndef FIT_FIX_HAS_CONSTEXPR
+#if __cplusplus >= 201402L && !defined(_MSC_VER)
+#define FIT_FIX_HAS_CONSTEXPR 1
+#else
 #define FIT_FIX_HAS_CONSTEXPR 0
 #endif
+#endif
 
 #if FIT_FIX_HAS_CONSTEXPR
 #define FIT_FIX_CONSTEXPR constexpr
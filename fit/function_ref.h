@@ -0,0 +1,167 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    function_ref.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_REF_H
+#define FIT_GUARD_FUNCTION_REF_H
+
+/// function_ref
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `function_ref` class is a non-owning reference to a function object,
+/// which erases its type, so it can be passed to non-template functions. It
+/// only stores a pointer to the function object and a pointer to a function
+/// that calls it, so it never allocates and is trivially copyable. Unlike
+/// `std::function`, the function object is not copied, so it must outlive
+/// the `function_ref`.
+///
+/// Function pointers are stored directly, rather than storing a pointer to
+/// them, so a `function_ref` can be initialized from a function name.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Signature>
+///     class function_ref;
+///
+///     template<class R, class... Ts>
+///     class function_ref<R(Ts...)>
+///     {
+///         template<class F>
+///         constexpr function_ref(const F& f);
+///
+///         R operator()(Ts... xs) const;
+///     };
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///
+/// Example
+/// -------
+///
+///     int apply_twice(fit::function_ref<int(int)> f, int x)
+///     {
+///         return f(f(x));
+///     }
+///
+///     auto add_two = fit::partial(sum_f())(2);
+///     assert(apply_twice(add_two, 1) == 5);
+///
+
+#include <type_traits>
+#include <fit/is_callable.h>
+#include <fit/detail/forward.h>
+
+namespace fit {
+
+template<class Signature>
+class function_ref;
+
+namespace detail {
+
+union function_ref_storage
+{
+    const void* object;
+    void (*function)();
+
+    constexpr function_ref_storage(const void* p) : object(p)
+    {}
+
+    constexpr function_ref_storage(void (*f)()) : function(f)
+    {}
+};
+
+template<class R>
+struct function_ref_invoke
+{
+    template<class F, class... Ts>
+    static R call(const F& f, Ts&&... xs)
+    {
+        return f(fit::forward<Ts>(xs)...);
+    }
+};
+
+template<>
+struct function_ref_invoke<void>
+{
+    template<class F, class... Ts>
+    static void call(const F& f, Ts&&... xs)
+    {
+        f(fit::forward<Ts>(xs)...);
+    }
+};
+
+template<class T>
+struct is_function_ref
+: std::false_type
+{};
+
+template<class Signature>
+struct is_function_ref<function_ref<Signature>>
+: std::true_type
+{};
+
+template<class F, class... Ts>
+struct is_function_ref_constructible
+: std::integral_constant<bool,
+    !is_function_ref<typename std::decay<F>::type>::value &&
+    is_callable<const typename std::remove_reference<F>::type&, Ts...>::value
+>
+{};
+
+}
+
+template<class R, class... Ts>
+class function_ref<R(Ts...)>
+{
+    typedef detail::function_ref_storage storage;
+    storage s;
+    R (*invoke)(storage, Ts...);
+
+    template<class F>
+    static R invoke_object(storage s, Ts... xs)
+    {
+        return detail::function_ref_invoke<R>::call(*static_cast<const F*>(s.object), fit::forward<Ts>(xs)...);
+    }
+
+    template<class F>
+    static R invoke_function(storage s, Ts... xs)
+    {
+        return detail::function_ref_invoke<R>::call(reinterpret_cast<F*>(s.function), fit::forward<Ts>(xs)...);
+    }
+public:
+    template<class F, typename std::enable_if<(
+        detail::is_function_ref_constructible<F, Ts...>::value &&
+        !std::is_function<F>::value
+    ), int>::type = 0>
+    constexpr function_ref(const F& f)
+    : s(static_cast<const void*>(&f)), invoke(&invoke_object<F>)
+    {}
+
+    template<class F, typename std::enable_if<(
+        detail::is_function_ref_constructible<F*, Ts...>::value &&
+        std::is_function<F>::value
+    ), int>::type = 0>
+    function_ref(F* f)
+    : s(reinterpret_cast<void (*)()>(f)), invoke(&invoke_function<F>)
+    {}
+
+    R operator()(Ts... xs) const
+    {
+        return invoke(s, fit::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+#endif
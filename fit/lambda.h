@@ -15,7 +15,10 @@
 /// -----------
 /// 
 /// The `FIT_STATIC_LAMBDA` macro allows initializing non-capturing lambdas at
-/// compile-time in a `constexpr` expression.
+/// compile-time in a `constexpr` expression. On compilers where lambdas are
+/// default constructible and can be used in `constexpr` functions (ie C++20),
+/// the function can also be called in a `constexpr` expression. This can be
+/// checked with `FIT_HAS_CONSTEXPR_LAMBDA`.
 /// 
 /// Example
 /// -------
@@ -34,7 +37,8 @@
 /// The `FIT_STATIC_LAMBDA_FUNCTION` macro allows initializing a global
 /// function object that contains non-capturing lambdas. It also ensures that
 /// the global function object has a unique address across translation units.
-/// This helps prevent possible ODR-violations.
+/// This helps prevent possible ODR-violations. However, because of this, the
+/// function cannot be called in a `constexpr` expression.
 /// 
 /// Example
 /// -------
@@ -56,6 +60,14 @@
 
 #define FIT_HAS_STATIC_LAMBDA 1
 
+#ifndef FIT_HAS_CONSTEXPR_LAMBDA
+#if __cplusplus > 201703L && !defined(_MSC_VER)
+#define FIT_HAS_CONSTEXPR_LAMBDA 1
+#else
+#define FIT_HAS_CONSTEXPR_LAMBDA 0
+#endif
+#endif
+
 #ifndef FIT_REWRITE_STATIC_LAMBDA
 #ifdef _MSC_VER
 #define FIT_REWRITE_STATIC_LAMBDA 1
@@ -81,6 +93,20 @@ struct static_function_wrapper
     : failure_for<F>
     {};
 
+#if FIT_HAS_CONSTEXPR_LAMBDA
+    template<class... Ts>
+    constexpr F base_function(Ts&&...) const
+    {
+        return F();
+    }
+
+    template<class... Ts>
+    constexpr FIT_SFINAE_RESULT(const F&, id_<Ts>...) 
+    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        F()(fit::forward<Ts>(xs)...)
+    );
+#else
     template<class... Ts>
     const F& base_function(Ts&&...) const
     {
@@ -95,6 +121,7 @@ struct static_function_wrapper
     (
         FIT_RETURNS_REINTERPRET_CAST(const F&)(*FIT_CONST_THIS)(fit::forward<Ts>(xs)...)
     );
+#endif
 };
 
 struct static_function_wrapper_factor
@@ -46,6 +46,46 @@
 ///     auto increment = lazy(add)(_1, 1);
 ///     assert(increment(5) == 6);
 /// 
+/// lazy_hoist
+/// ==========
+/// 
+/// Description
+/// -----------
+/// 
+/// The `lazy_hoist` function takes a lazy expression and evaluates every
+/// subexpression that doesn't depend on any placeholders, and stores the
+/// result in the new expression. So these subexpressions are only evaluated
+/// once, when `lazy_hoist` is called, rather than every time the expression
+/// is called. Only the work that depends on the arguments is done when the
+/// new expression is called.
+/// 
+/// Subexpressions are only evaluated if they are built with `lazy`. Other
+/// bind expressions, such as from `std::bind`, are left as they are. So are
+/// subexpressions that take a `std::reference_wrapper`, since the value it
+/// refers to can change after `lazy_hoist` is called.
+/// 
+/// Synopsis
+/// --------
+/// 
+///     template<class Expression>
+///     auto lazy_hoist(const Expression& e);
+/// 
+/// Requirements
+/// ------------
+/// 
+/// Expression must be:
+/// 
+///     FunctionObject
+///     CopyConstructible
+/// 
+/// Example
+/// -------
+/// 
+///     auto square = [](int x) { return x*x; };
+///     // square(42) is computed once here, rather than for every call
+///     auto f = lazy_hoist(lazy(add)(lazy(square)(42), _1));
+///     assert(f(1) == 1765);
+/// 
 
 #include <fit/args.h>
 #include <fit/conditional.h>
@@ -53,6 +93,7 @@
 #include <fit/static.h>
 #include <fit/detail/delegate.h>
 #include <fit/detail/compressed_pair.h>
+#include <fit/detail/and.h>
 #include <fit/pack.h>
 #include <fit/detail/make.h>
 #include <fit/detail/static_const_var.h>
@@ -273,6 +314,97 @@ struct lazy_adaptor : F
 
 FIT_DECLARE_STATIC_VAR(lazy, detail::make<lazy_adaptor>);
 
+namespace detail {
+
+template<class T>
+struct lazy_hoisted
+{
+    T value;
+
+    template<class... Ts>
+    constexpr const T& operator()(Ts&&...) const
+    {
+        return value;
+    }
+};
+
+// A reference_wrapper is read when the expression is called, so it isn't
+// constant, just like in eval_columns
+template<class T, class=void>
+struct lazy_is_constant
+: std::integral_constant<bool, 
+    std::is_placeholder<T>::value == 0 && 
+    !std::is_bind_expression<T>::value && 
+    !is_reference_wrapper<typename std::remove_cv<typename std::remove_reference<T>::type>::type>::value
+>
+{};
+
+template<class F, class Seq, class... Ts>
+struct lazy_is_constant<lazy_invoker<F, pack_base<Seq, Ts...>>>
+: and_<lazy_is_constant<Ts>...>
+{};
+
+template<class F>
+struct lazy_is_constant<lazy_nullary_invoker<F>>
+: std::true_type
+{};
+
+template<class T>
+struct lazy_is_constant<lazy_hoisted<T>>
+: std::true_type
+{};
+
+struct lazy_hoist_f;
+
+struct lazy_hoist_pack
+{
+    template<class... Ts>
+    constexpr auto operator()(const Ts&... xs) const FIT_RETURNS
+    (
+        pack(lazy_hoist_f()(xs)...)
+    );
+};
+
+struct lazy_hoist_f
+{
+    template<class T, typename std::enable_if<(
+        !std::is_bind_expression<T>::value
+    ), int>::type = 0>
+    constexpr T operator()(const T& x) const
+    {
+        return x;
+    }
+
+    template<class T, class R=typename std::decay<decltype(std::declval<const T&>()())>::type, 
+    typename std::enable_if<(
+        std::is_bind_expression<T>::value && lazy_is_constant<T>::value
+    ), int>::type = 0>
+    constexpr lazy_hoisted<R> operator()(const T& x) const
+    {
+        return lazy_hoisted<R>{x()};
+    }
+
+    template<class T, typename std::enable_if<(
+        std::is_bind_expression<T>::value && !lazy_is_constant<T>::value
+    ), int>::type = 0>
+    constexpr T operator()(const T& x) const
+    {
+        return x;
+    }
+
+    template<class F, class Pack, typename std::enable_if<(
+        !lazy_is_constant<lazy_invoker<F, Pack>>::value
+    ), int>::type = 0>
+    constexpr auto operator()(const lazy_invoker<F, Pack>& x) const FIT_RETURNS
+    (
+        make_lazy_invoker(x.base_function(), x.get_pack()(lazy_hoist_pack()))
+    );
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(lazy_hoist, detail::lazy_hoist_f);
+
 }
 
 namespace std {
@@ -285,6 +417,11 @@ namespace std {
     struct is_bind_expression<fit::detail::lazy_nullary_invoker<F>>
     : std::true_type
     {};
+
+    template<class T>
+    struct is_bind_expression<fit::detail::lazy_hoisted<T>>
+    : std::true_type
+    {};
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,86 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    make_table.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_MAKE_TABLE_H
+#define FIT_GUARD_MAKE_TABLE_H
+
+/// make_table
+/// ==========
+///
+/// Description
+/// -----------
+///
+/// The `make_table` function evaluates the function for every index from `0`
+/// to `N-1`, and stores the results in a `std::array`. The index is passed to
+/// the function as a `std::integral_constant<std::size_t, I>`, which is also
+/// implicitly convertible to `std::size_t`. If the function can be called in
+/// a `constexpr` context, then the table can be initialized at compile-time,
+/// and will be placed in read-only memory rather than being built at startup.
+///
+/// Synopsis
+/// --------
+///
+///     template<std::size_t N, class F>
+///     constexpr std::array<R, N> make_table(F f);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///
+/// Example
+/// -------
+///
+///     struct square
+///     {
+///         constexpr std::size_t operator()(std::size_t i) const
+///         {
+///             return i*i;
+///         }
+///     };
+///
+///     static constexpr auto squares = fit::make_table<16>(square());
+///     static_assert(squares[3] == 9, "Failed");
+///
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <fit/detail/seq.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class F, std::size_t N>
+struct make_table_result
+{
+    typedef typename std::decay<decltype(
+        std::declval<const F&>()(std::integral_constant<std::size_t, 0>())
+    )>::type value_type;
+    typedef std::array<value_type, N> type;
+};
+
+template<std::size_t N, class F, int... Ns>
+constexpr typename make_table_result<F, N>::type make_table_impl(const F& f, seq<Ns...>)
+{
+    return {{ f(std::integral_constant<std::size_t, Ns>())... }};
+}
+
+}
+
+template<std::size_t N, class F>
+constexpr typename detail::make_table_result<F, N>::type make_table(F f)
+{
+    return detail::make_table_impl<N>(f, typename detail::gens<N>::type());
+}
+
+}
+
+#endif
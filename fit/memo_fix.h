@@ -0,0 +1,345 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    memo_fix.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_MEMO_FIX_H
+#define FIT_GUARD_FUNCTION_MEMO_FIX_H
+
+/// memo_fix
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `memo_fix` function adaptor implements a memoizing fixed-point
+/// combinator. Like `fix`, the first parameter passed to the function is the
+/// function itself, however, each recursive call through this parameter will
+/// first look up the result in a cache, and only call the function when the
+/// arguments haven't been seen before. This turns exponential recursions,
+/// such as fibonacci or edit distance, into polynomial ones.
+///
+/// By default, a new cache is created for every call to the adaptor, and the
+/// cache is keyed on the decayed types of the arguments passed to the
+/// adaptor. Recursive calls will convert their arguments to these types. A
+/// persistent cache can be used instead by calling `with_cache`, which
+/// returns a function that uses the cache passed in.
+///
+/// The cache is chosen with the `Cache` parameter, which can be:
+///
+/// * `memo_hash`: An open-addressing flat hash map, which is the default.
+/// * `memo_dense<N>`: A dense array for a single integral argument in the
+/// range `[0, N)`. Arguments outside of this range are not cached.
+///
+/// Note: Just like `fix`, the return type of the function must not be
+/// deduced from the recursive call.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     memo_fix_adaptor<F> memo_fix(F f);
+///
+///     template<class F, class Cache=memo_hash>
+///     struct memo_fix_adaptor;
+///
+///     template<class R, class... Ts>
+///     class memo_hash_map;
+///
+///     template<class R, std::size_t N>
+///     class memo_array;
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// The result and the decayed argument types must be DefaultConstructible
+/// and CopyConstructible. With `memo_hash`, the argument types must also be
+/// EqualityComparable and hashable with `std::hash`.
+///
+/// Example
+/// -------
+///
+///     struct fib_f
+///     {
+///         template<class Self>
+///         long long operator()(Self self, int n) const
+///         {
+///             return n < 2 ? n : self(n-1) + self(n-2);
+///         }
+///     };
+///
+///     long long r = fit::memo_fix(fib_f())(80);
+///     assert(r == 23416728348467685LL);
+///
+///     fit::memo_hash_map<long long, int> cache;
+///     auto fib = fit::memo_fix(fib_f()).with_cache(cache);
+///     assert(fib(80) == 23416728348467685LL);
+///
+
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <tuple>
+#include <vector>
+#include <fit/always.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/make.h>
+#include <fit/detail/seq.h>
+#include <fit/detail/static_const_var.h>
+
+namespace fit {
+
+namespace detail {
+
+inline std::size_t memo_hash_combine(std::size_t seed, std::size_t h)
+{
+    return seed ^ (h + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+template<class... Ts>
+struct memo_key_hash
+{
+    template<int... Ns>
+    static std::size_t hash(const std::tuple<Ts...>& t, seq<Ns...>)
+    {
+        std::size_t seed = 0;
+        (void)std::initializer_list<int>{0, (seed = memo_hash_combine(seed, std::hash<Ts>()(std::get<Ns>(t))), 0)...};
+        return seed;
+    }
+
+    std::size_t operator()(const std::tuple<Ts...>& t) const
+    {
+        return hash(t, typename gens<sizeof...(Ts)>::type());
+    }
+};
+
+}
+
+template<class R, class... Ts>
+class memo_hash_map
+{
+    typedef std::tuple<Ts...> key_type;
+    struct slot
+    {
+        slot() : used(false)
+        {}
+        bool used;
+        key_type key;
+        R value;
+    };
+    std::vector<slot> slots;
+    std::size_t count;
+
+    std::size_t probe(const key_type& key) const
+    {
+        std::size_t mask = slots.size() - 1;
+        std::size_t i = detail::memo_key_hash<Ts...>()(key) & mask;
+        while (slots[i].used && !(slots[i].key == key)) i = (i + 1) & mask;
+        return i;
+    }
+
+    void grow()
+    {
+        std::vector<slot> old(slots.empty() ? 16 : slots.size() * 2);
+        old.swap(slots);
+        for(auto&& s:old) if (s.used) slots[this->probe(s.key)] = fit::move(s);
+    }
+public:
+    memo_hash_map() : count(0)
+    {}
+
+    const R* find(const Ts&... xs) const
+    {
+        if (count == 0) return nullptr;
+        const slot& s = slots[this->probe(key_type(xs...))];
+        return s.used ? &s.value : nullptr;
+    }
+
+    void insert(const R& r, const Ts&... xs)
+    {
+        // Keep the load factor at or below one half
+        if (2 * (count + 1) > slots.size()) this->grow();
+        key_type key(xs...);
+        slot& s = slots[this->probe(key)];
+        if (!s.used)
+        {
+            s.used = true;
+            s.key = fit::move(key);
+            count++;
+        }
+        s.value = r;
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    void clear()
+    {
+        slots.clear();
+        count = 0;
+    }
+};
+
+template<class R, std::size_t N>
+class memo_array
+{
+    std::vector<R> values;
+    std::vector<bool> filled;
+
+    template<class T>
+    static bool in_range(T x)
+    {
+        return !(x < T(0)) && static_cast<unsigned long long>(x) < N;
+    }
+public:
+    memo_array() : values(N), filled(N, false)
+    {}
+
+    template<class T>
+    const R* find(T x) const
+    {
+        return in_range(x) && filled[x] ? &values[x] : nullptr;
+    }
+
+    template<class T>
+    void insert(const R& r, T x)
+    {
+        if (!in_range(x)) return;
+        values[x] = r;
+        filled[x] = true;
+    }
+
+    void clear()
+    {
+        filled.assign(N, false);
+    }
+};
+
+struct memo_hash
+{
+    template<class R, class... Ts>
+    struct apply
+    {
+        typedef memo_hash_map<R, Ts...> type;
+    };
+};
+
+template<std::size_t N>
+struct memo_dense
+{
+    template<class R, class... Ts>
+    struct apply
+    {
+        static_assert(sizeof...(Ts) == 1, "memo_dense can only be used with a single integral argument");
+        typedef memo_array<R, N> type;
+    };
+};
+
+namespace detail {
+
+template<class Storage>
+struct memo_storage
+{
+    template<class R, class... Ts>
+    struct apply
+    {
+        typedef Storage type;
+    };
+};
+
+template<class State>
+struct memo_fix_self
+{
+    State* state;
+
+    template<class... Xs, class S=State>
+    typename S::result_type operator()(Xs&&... xs) const
+    {
+        return state->call(fit::forward<Xs>(xs)...);
+    }
+};
+
+template<class F, class Cache, class... Ts>
+struct memo_fix_state
+{
+    typedef memo_fix_self<memo_fix_state> self;
+    typedef typename std::decay<decltype(
+        std::declval<const F&>()(std::declval<const self&>(), std::declval<const Ts&>()...)
+    )>::type result_type;
+    typedef typename Cache::template apply<result_type, Ts...>::type cache_type;
+
+    const F& f;
+    cache_type& cache;
+
+    memo_fix_state(const F& f, cache_type& cache) : f(f), cache(cache)
+    {}
+
+    result_type call(const Ts&... xs)
+    {
+        if (const result_type* r = cache.find(xs...)) return *r;
+        self s = { this };
+        result_type r = f(s, xs...);
+        cache.insert(r, xs...);
+        return r;
+    }
+};
+
+template<class F, class Storage>
+struct memo_fix_cached : F
+{
+    Storage* cache;
+
+    template<class X>
+    memo_fix_cached(X&& x, Storage& s) : F(fit::forward<X>(x)), cache(&s)
+    {}
+
+    template<class... Ts, class State=memo_fix_state<F, memo_storage<Storage>, typename std::decay<Ts>::type...>>
+    typename State::result_type operator()(Ts&&... xs) const
+    {
+        return State(static_cast<const F&>(*this), *cache).call(xs...);
+    }
+};
+
+}
+
+template<class F, class Cache=memo_hash>
+struct memo_fix_adaptor : F
+{
+    typedef memo_fix_adaptor fit_rewritable1_tag;
+    FIT_INHERIT_CONSTRUCTOR(memo_fix_adaptor, F);
+
+    template<class... Ts>
+    const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts, class State=detail::memo_fix_state<F, Cache, typename std::decay<Ts>::type...>>
+    typename State::result_type operator()(Ts&&... xs) const
+    {
+        typename State::cache_type cache;
+        return State(this->base_function(xs...), cache).call(xs...);
+    }
+
+    template<class Storage>
+    detail::memo_fix_cached<F, Storage> with_cache(Storage& cache) const
+    {
+        return detail::memo_fix_cached<F, Storage>(this->base_function(cache), cache);
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(memo_fix, detail::make<memo_fix_adaptor>);
+
+}
+
+#endif
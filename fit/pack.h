@@ -19,6 +19,18 @@
 /// a sequence that can be unpacked with `unpack_adaptor` as well. Also,
 /// `pack_join` can be used to join multiple packs together.
 /// 
+/// A single element can be read with `pack_get`, which takes the index of the
+/// element as a template parameter, without unpacking the rest of the pack.
+/// The element is returned by reference, as an rvalue if the pack is an
+/// rvalue. The number of elements in a pack is given by `pack_size`.
+/// 
+/// The elements of a pack are laid out in the order they are passed, so
+/// there can be padding between them. The `pack_packed` function captures
+/// its elements like `pack` does, but lays them out from the largest
+/// alignment to the smallest, which leaves padding only at the end. The
+/// elements are still unpacked and indexed with `pack_get` in the order they
+/// are passed. A packed pack can't be joined with `pack_join`.
+/// 
 /// Synopsis
 /// --------
 /// 
@@ -34,10 +46,22 @@
 ///     template<class... Ts>
 ///     constexpr auto pack_decay(Ts&&... xs);
 /// 
+///     // Capture like pack, but lay out the elements to minimize padding
+///     template<class... Ts>
+///     constexpr auto pack_packed(Ts&&... xs);
+/// 
 ///     // Join multiple packs together
 ///     template<class... Ts>
 ///     constexpr auto pack_join(Ts&&... xs);
 /// 
+///     // Get the element at index I
+///     template<int I, class Pack>
+///     constexpr auto pack_get(Pack&& p);
+/// 
+///     // The number of elements in the pack
+///     template<class Pack>
+///     struct pack_size;
+/// 
 /// 
 /// Example
 /// -------
@@ -53,8 +77,12 @@
 /// 
 ///     int r = pack(3, 2)(sum());
 ///     assert(r == 5);
+///     assert(pack_get<1>(pack(3, 2)) == 2);
+///     static_assert(pack_size<decltype(pack(3, 2))>::value == 2, "");
 /// 
 
+#include <tuple>
+#include <fit/args.h>
 #include <fit/detail/seq.h>
 #include <fit/detail/delegate.h>
 #include <fit/detail/remove_rvalue_reference.h>
@@ -95,8 +123,8 @@ template<class T, class Tag>
 struct pack_holder
 : std::conditional<
         std::is_empty<T>::value && 
-        std::is_literal_type<T>::value && 
-        is_default_constructible<T>::value,
+        is_default_constructible<T>::value &&
+        is_constexpr_default_constructible<T>::value,
     alias_static<T, Tag>,
     alias<T, Tag>
 >
@@ -350,11 +378,172 @@ struct pack_join_f
     );
 };
 
+template<int I, class... Ts>
+struct pack_element
+{
+    typedef typename std::tuple_element<I, std::tuple<Ts...>>::type type;
+};
+
+// Goes straight to the holder of the element, so none of the other elements
+// are touched
+template<int I, int... Ns, class... Ts>
+constexpr auto pack_get_element(const pack_base<seq<Ns...>, Ts...>& x) FIT_RETURNS
+(alias_value<pack_tag<seq<I>, Ts...>, typename pack_element<I, Ts...>::type>(x));
+
+template<int I, int... Ns, class... Ts>
+constexpr auto pack_get_element(pack_base<seq<Ns...>, Ts...>& x) FIT_RETURNS
+(alias_value<pack_tag<seq<I>, Ts...>, typename pack_element<I, Ts...>::type>(x));
+
+// References stay lvalues when the pack is an rvalue
+template<int I, int... Ns, class... Ts>
+constexpr auto pack_get_element(pack_base<seq<Ns...>, Ts...>&& x) FIT_RETURNS
+(pack_get<typename pack_element<I, Ts...>::type, pack_tag<seq<I>, Ts...>>(fit::move(x)));
+
+template<class P>
+struct pack_size_base;
+
+template<int... Ns, class... Ts>
+struct pack_size_base<pack_base<seq<Ns...>, Ts...>>
+: std::integral_constant<int, sizeof...(Ts)>
+{};
+
+template<class T>
+struct pack_align
+: std::alignment_of<alias<T>>
+{};
+
+// The slot where element i is stored, which comes after every element with
+// a larger alignment, and after the earlier elements with the same alignment
+constexpr int pack_packed_position(int, std::size_t, int)
+{
+    return 0;
+}
+
+template<class... Ts>
+constexpr int pack_packed_position(int i, std::size_t a, int j, std::size_t b, Ts... bs)
+{
+    return ((b > a || (b == a && j < i)) ? 1 : 0) + pack_packed_position(i, a, j+1, bs...);
+}
+
+// The element that is stored in slot k
+constexpr int pack_packed_index(int, int)
+{
+    return -1;
 }
 
+template<class... Ts>
+constexpr int pack_packed_index(int k, int i, int p, Ts... ps)
+{
+    return p == k ? i : pack_packed_index(k, i+1, ps...);
+}
+
+constexpr int pack_packed_at(int, int)
+{
+    return -1;
+}
+
+template<class... Ts>
+constexpr int pack_packed_at(int i, int j, int p, Ts... ps)
+{
+    return i == j ? p : pack_packed_at(i, j+1, ps...);
+}
+
+template<class Seq, class... Ts>
+struct pack_packed_positions;
+
+template<int... Ns, class... Ts>
+struct pack_packed_positions<seq<Ns...>, Ts...>
+{
+    typedef seq<pack_packed_position(Ns, pack_align<Ts>::value, 0, pack_align<Ts>::value...)...> type;
+};
+
+template<class Seq, class Positions, class... Ts>
+struct pack_packed_base;
+
+// Element I of a packed pack is element Ps[I] of the pack it is stored in
+#define FIT_DETAIL_PACK_PACKED_GET_ELEMENT(ref, move) \
+template<int I, int... Ns, int... Ps, class... Ts> \
+constexpr auto pack_get_element(pack_packed_base<seq<Ns...>, seq<Ps...>, Ts...> ref x) \
+FIT_RETURNS(pack_get_element<pack_packed_at(I, 0, Ps...)>( \
+    static_cast<typename pack_packed_base<seq<Ns...>, seq<Ps...>, Ts...>::base ref>(x)))
+FIT_UNARY_PERFECT_FOREACH(FIT_DETAIL_PACK_PACKED_GET_ELEMENT)
+
+struct pack_packed_construct
+{};
+
+template<int... Ns, int... Ps, class... Ts>
+struct pack_packed_base<seq<Ns...>, seq<Ps...>, Ts...>
+: pack_base<seq<Ns...>, typename pack_element<pack_packed_index(Ns, 0, Ps...), Ts...>::type...>
+{
+    typedef pack_base<seq<Ns...>, typename pack_element<pack_packed_index(Ns, 0, Ps...), Ts...>::type...> base;
+
+    FIT_INHERIT_DEFAULT(pack_packed_base, Ts...);
+
+    template<class... Xs>
+    constexpr pack_packed_base(pack_packed_construct, Xs&&... xs)
+    : base(get_args<pack_packed_index(Ns, 0, Ps...)+1>(fit::forward<Xs>(xs)...)...)
+    {}
+
+    FIT_RETURNS_CLASS(pack_packed_base);
+
+    template<class F>
+    constexpr auto operator()(F&& f) const FIT_RETURNS
+    (
+        f(pack_get_element<Ns>(*FIT_CONST_THIS)...)
+    );
+
+    template<class F>
+    struct apply
+    : F::template apply<Ts...>
+    {};
+};
+
+#define FIT_DETAIL_UNPACK_PACK_PACKED_BASE(ref, move) \
+template<class F, int... Ns, int... Ps, class... Ts> \
+constexpr auto unpack_pack_packed_base(F&& f, pack_packed_base<seq<Ns...>, seq<Ps...>, Ts...> ref x) \
+FIT_RETURNS(f(pack_get_element<Ns>(move(x))...))
+FIT_UNARY_PERFECT_FOREACH(FIT_DETAIL_UNPACK_PACK_PACKED_BASE)
+
+template<class Seq, class Positions, class... Ts>
+struct pack_size_base<pack_packed_base<Seq, Positions, Ts...>>
+: std::integral_constant<int, sizeof...(Ts)>
+{};
+
+template<class... Ts>
+struct pack_packed_type
+{
+    typedef typename gens<sizeof...(Ts)>::type seq_type;
+    typedef pack_packed_base<seq_type, typename pack_packed_positions<seq_type, Ts...>::type, Ts...> type;
+};
+
+struct pack_packed_f
+{
+    template<class... Ts>
+    constexpr typename pack_packed_type<typename remove_rvalue_reference<Ts>::type...>::type
+    operator()(Ts&&... xs) const
+    {
+        return typename pack_packed_type<typename remove_rvalue_reference<Ts>::type...>::type(
+            pack_packed_construct(), fit::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+template<class P>
+struct pack_size
+: detail::pack_size_base<typename std::remove_cv<typename std::remove_reference<P>::type>::type>
+{};
+
+template<int I, class P>
+constexpr auto pack_get(P&& p) FIT_RETURNS
+(
+    detail::pack_get_element<I>(fit::forward<P>(p))
+);
+
 FIT_DECLARE_STATIC_VAR(pack, detail::pack_f);
 FIT_DECLARE_STATIC_VAR(pack_forward, detail::pack_forward_f);
 FIT_DECLARE_STATIC_VAR(pack_decay, detail::pack_decay_f);
+FIT_DECLARE_STATIC_VAR(pack_packed, detail::pack_packed_f);
 
 FIT_DECLARE_STATIC_VAR(pack_join, detail::pack_join_f);
 
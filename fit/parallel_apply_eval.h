@@ -0,0 +1,283 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    parallel_apply_eval.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PARALLEL_APPLY_EVAL_H
+#define FIT_GUARD_PARALLEL_APPLY_EVAL_H
+
+/// parallel_apply_eval
+/// ===================
+///
+/// Description
+/// -----------
+///
+/// The `parallel_apply_eval` function works like `apply_eval`, except the
+/// arguments are evaluated concurrently rather than in order. Each argument
+/// except the first is submitted to an executor. The calling thread evaluates
+/// the first argument, and then evaluates any of the other arguments that
+/// the executor hasn't started yet. So the call makes progress even when the
+/// executor is busy, or when it is called from one of the executor's own
+/// threads. Once every argument has been evaluated, the function is called
+/// with the results.
+///
+/// If any of the evaluations throw, the function is not called, and the
+/// exception from the leftmost argument that threw is rethrown, no matter
+/// which evaluation finished first. The other exceptions are discarded.
+///
+/// By default, the `default_thread_pool` is used. The `parallel_apply_eval_with`
+/// function takes the executor to use as its first parameter.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F, class... Ts>
+///     auto parallel_apply_eval(const F& f, Ts&&... xs);
+///
+///     template<class Executor, class F, class... Ts>
+///     auto parallel_apply_eval_with(Executor& e, const F& f, Ts&&... xs);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///
+/// Ts must be:
+///
+///     EvaluatableFunctionObject
+///
+/// Example
+/// -------
+///
+///     auto r = fit::parallel_apply_eval(sum(),
+///         [] { return lookup("a"); },
+///         [] { return lookup("b"); }
+///     );
+///
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <fit/eval.h>
+#include <fit/thread_pool.h>
+#include <fit/detail/forward.h>
+#include <fit/detail/seq.h>
+#include <fit/detail/static_const_var.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class T>
+struct parallel_eval_slot
+{
+    typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage;
+    bool has_value;
+
+    parallel_eval_slot() : has_value(false)
+    {}
+
+    parallel_eval_slot(const parallel_eval_slot&) = delete;
+    parallel_eval_slot& operator=(const parallel_eval_slot&) = delete;
+
+    template<class X>
+    void set(X&& x)
+    {
+        new (&storage) T(fit::eval(fit::forward<X>(x)));
+        has_value = true;
+    }
+
+    T&& get()
+    {
+        return static_cast<T&&>(*reinterpret_cast<T*>(&storage));
+    }
+
+    ~parallel_eval_slot()
+    {
+        if (has_value) reinterpret_cast<T*>(&storage)->~T();
+    }
+};
+
+template<class T>
+struct parallel_eval_slot<T&>
+{
+    T* value;
+
+    template<class X>
+    void set(X&& x)
+    {
+        value = &fit::eval(fit::forward<X>(x));
+    }
+
+    T& get()
+    {
+        return *value;
+    }
+};
+
+template<class T>
+struct parallel_eval_slot<T&&>
+{
+    T* value;
+
+    template<class X>
+    void set(X&& x)
+    {
+        T&& r = fit::eval(fit::forward<X>(x));
+        value = &r;
+    }
+
+    T&& get()
+    {
+        return static_cast<T&&>(*value);
+    }
+};
+
+template<class... Rs>
+struct parallel_eval_state
+{
+    std::tuple<parallel_eval_slot<Rs>...> results;
+    std::exception_ptr errors[sizeof...(Rs)];
+    std::atomic<bool> claimed[sizeof...(Rs)];
+    std::size_t remaining;
+    std::mutex m;
+    std::condition_variable cv;
+
+    parallel_eval_state() : remaining(sizeof...(Rs))
+    {
+        for(std::atomic<bool>& c:claimed) c.store(false);
+    }
+
+    template<int I>
+    bool claim()
+    {
+        return !claimed[I].exchange(true);
+    }
+
+    template<int I, class T>
+    void try_run(typename std::remove_reference<T>::type& x)
+    {
+        if (this->template claim<I>()) this->template run<I, T>(x);
+    }
+
+    template<int I, class T>
+    void run(typename std::remove_reference<T>::type& x)
+    {
+        try
+        {
+            std::get<I>(results).set(static_cast<T&&>(x));
+        }
+        catch(...)
+        {
+            errors[I] = std::current_exception();
+        }
+        std::lock_guard<std::mutex> lock(m);
+        if (--remaining == 0) cv.notify_all();
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return remaining == 0; });
+        for(std::exception_ptr& e:errors)
+        {
+            if (e) std::rethrow_exception(e);
+        }
+    }
+};
+
+template<int I, class State, class T>
+struct parallel_eval_task
+{
+    std::shared_ptr<State> state;
+    typename std::remove_reference<T>::type* x;
+
+    // The caller waits until every argument has been evaluated, but once it
+    // has claimed and evaluated this argument itself, it can return before
+    // the task runs. So the task has to claim the argument before touching
+    // x, which is only alive until the caller returns.
+    void operator()() const
+    {
+        if (state->template claim<I>()) state->template run<I, T>(*x);
+    }
+};
+
+template<int I, class Executor, class State, class T>
+void parallel_eval_submit(Executor& e, const std::shared_ptr<State>& state, T&& x)
+{
+    if (I == 0) return;
+    try
+    {
+        e.execute(parallel_eval_task<I, State, T>{state, &x});
+    }
+    catch(...)
+    {
+        // The calling thread will evaluate it instead
+    }
+}
+
+template<class F, class... Ts>
+struct parallel_apply_eval_result
+{
+    typedef decltype(std::declval<const F&>()(fit::eval(std::declval<Ts>())...)) type;
+};
+
+template<class Executor, class F, int... Ns, class... Ts>
+typename parallel_apply_eval_result<F, Ts...>::type
+parallel_apply_eval_impl(Executor& e, const F& f, seq<Ns...>, Ts&&... xs)
+{
+    typedef parallel_eval_state<decltype(fit::eval(std::declval<Ts>()))...> state_type;
+    std::shared_ptr<state_type> state = std::make_shared<state_type>();
+    int submit[] = { 0, (parallel_eval_submit<Ns>(e, state, fit::forward<Ts>(xs)), 0)... };
+    int run[] = { 0, (state->template try_run<Ns, Ts>(xs), 0)... };
+    (void)submit;
+    (void)run;
+    state->wait();
+    return f(std::get<Ns>(state->results).get()...);
+}
+
+template<class Executor, class F>
+typename parallel_apply_eval_result<F>::type
+parallel_apply_eval_impl(Executor&, const F& f, seq<>)
+{
+    return f();
+}
+
+struct parallel_apply_eval_with_f
+{
+    template<class Executor, class F, class... Ts>
+    typename parallel_apply_eval_result<F, Ts...>::type
+    operator()(Executor& e, const F& f, Ts&&... xs) const
+    {
+        return parallel_apply_eval_impl(e, f, typename gens<sizeof...(Ts)>::type(), fit::forward<Ts>(xs)...);
+    }
+};
+
+struct parallel_apply_eval_f
+{
+    template<class F, class... Ts>
+    typename parallel_apply_eval_result<F, Ts...>::type
+    operator()(const F& f, Ts&&... xs) const
+    {
+        return parallel_apply_eval_with_f()(default_thread_pool(), f, fit::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(parallel_apply_eval, detail::parallel_apply_eval_f);
+FIT_DECLARE_STATIC_VAR(parallel_apply_eval_with, detail::parallel_apply_eval_with_f);
+
+}
+
+#endif
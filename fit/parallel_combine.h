@@ -0,0 +1,159 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    parallel_combine.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PARALLEL_COMBINE_H
+#define FIT_GUARD_PARALLEL_COMBINE_H
+
+/// parallel_combine
+/// ================
+///
+/// Description
+/// -----------
+///
+/// The `parallel_combine` function adaptor works like `combine`, except each
+/// function is called with its argument concurrently. Each `gs[i](xs[i])`
+/// is evaluated as a task on the `default_work_stealing_pool`, using
+/// `parallel_apply_eval_with`, and then the main function is called with the
+/// results on the calling thread.
+///
+/// Scheduling a task costs far more than a small function call, so the
+/// functions are only called concurrently when the total cost of the
+/// arguments is at least `FIT_PARALLEL_COMBINE_THRESHOLD`, which defaults to
+/// 4096. Otherwise, or when there is only one argument, it is called exactly
+/// like `combine` on the calling thread. The cost of an argument is given by
+/// the `parallel_cost` trait. By default it is `x.size()` for arguments that
+/// have a `size` member function, and `1` for everything else. It can be
+/// specialized for other types.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F, class... Gs>
+///     constexpr parallel_combine_adaptor<F, Gs...> parallel_combine(F f, Gs... gs);
+///
+///     template<class T, class=void>
+///     struct parallel_cost
+///     {
+///         static std::size_t apply(const T& x);
+///     };
+///
+/// Requirements
+/// ------------
+///
+/// F and Gs must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Gs must also be safe to call from several threads at once.
+///
+/// Example
+/// -------
+///
+///     auto f = fit::parallel_combine(
+///         fit::_ + fit::_,
+///         [](const std::vector<int>& v) { return std::accumulate(v.begin(), v.end(), 0); },
+///         [](const std::vector<int>& v) { return std::accumulate(v.begin(), v.end(), 0); });
+///     assert(f(std::vector<int>(10000, 1), std::vector<int>(10000, 2)) == 30000);
+///
+
+#include <cstddef>
+#include <type_traits>
+#include <fit/combine.h>
+#include <fit/parallel_apply_eval.h>
+#include <fit/thread_pool.h>
+#include <fit/detail/holder.h>
+
+#ifndef FIT_PARALLEL_COMBINE_THRESHOLD
+#define FIT_PARALLEL_COMBINE_THRESHOLD 4096
+#endif
+
+namespace fit {
+
+template<class T, class=void>
+struct parallel_cost
+{
+    static constexpr std::size_t apply(const T&)
+    {
+        return 1;
+    }
+};
+
+template<class T>
+struct parallel_cost<T, typename detail::holder<
+    decltype(std::declval<const T&>().size())
+>::type>
+{
+    static constexpr std::size_t apply(const T& x)
+    {
+        return x.size();
+    }
+};
+
+namespace detail {
+
+constexpr std::size_t parallel_combine_cost()
+{
+    return 0;
+}
+
+template<class T, class... Ts>
+constexpr std::size_t parallel_combine_cost(const T& x, const Ts&... xs)
+{
+    return parallel_cost<T>::apply(x) + parallel_combine_cost(xs...);
+}
+
+template<class G, class T>
+struct parallel_combine_thunk
+{
+    const G& g;
+    typename std::remove_reference<T>::type& x;
+
+    auto operator()() const FIT_RETURNS
+    (g(static_cast<T&&>(x)));
+};
+
+template<class S, class F, class... Gs>
+struct parallel_combine_adaptor_base;
+
+template<int... Ns, class F, class... Gs>
+struct parallel_combine_adaptor_base<seq<Ns...>, F, Gs...>
+: combine_adaptor_base<seq<Ns...>, F, Gs...>
+{
+    typedef combine_adaptor_base<seq<Ns...>, F, Gs...> base_type;
+    FIT_INHERIT_CONSTRUCTOR(parallel_combine_adaptor_base, base_type)
+
+    template<class... Ts, class R=decltype(std::declval<const base_type&>()(std::declval<Ts>()...))>
+    R operator()(Ts&&... xs) const
+    {
+        if (sizeof...(Ts) < 2 || parallel_combine_cost(xs...) < FIT_PARALLEL_COMBINE_THRESHOLD)
+        {
+            return base_type::operator()(fit::forward<Ts>(xs)...);
+        }
+        return parallel_apply_eval_with_f()(
+            default_work_stealing_pool(),
+            this->base_function(xs...),
+            parallel_combine_thunk<Gs, Ts>{alias_value<pack_tag<seq<Ns>, Gs...>, Gs>(*this, xs), xs}...
+        );
+    }
+};
+
+}
+
+template<class F, class... Gs>
+struct parallel_combine_adaptor
+: detail::parallel_combine_adaptor_base<typename detail::gens<sizeof...(Gs)>::type, F, Gs...>
+{
+    typedef detail::parallel_combine_adaptor_base<typename detail::gens<sizeof...(Gs)>::type, F, Gs...> base_type;
+    FIT_INHERIT_CONSTRUCTOR(parallel_combine_adaptor, base_type)
+};
+
+FIT_DECLARE_STATIC_VAR(parallel_combine, detail::make<parallel_combine_adaptor>);
+
+}
+
+#endif
@@ -0,0 +1,229 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    permute.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PERMUTE_H
+#define FIT_GUARD_PERMUTE_H
+
+/// permute
+/// =======
+///
+/// Description
+/// -----------
+///
+/// The `permute` function adaptor reorders the parameters of a function. The
+/// `k`th parameter passed to the function is the parameter at index `Is[k]`,
+/// so `permute<2, 0, 1>(f)(x, y, z)` calls `f(z, x, y)`. The indices must be
+/// a permutation of `0` to `N-1`, which is checked at compile time, and the
+/// adaptor must be called with exactly `N` parameters.
+///
+/// The `select` function adaptor works the same way, but the indices can
+/// leave out parameters or repeat them, so `select<1, 1>(f)(x, y, z)` calls
+/// `f(y, y)`. It can be called with any number of parameters, as long as
+/// there are enough of them for every index. A parameter that is passed more
+/// than once is passed as an lvalue, so it can't be moved from twice.
+///
+/// Unlike nesting `flip` and `rotate`, the parameters are passed to the
+/// function in one step, however they are reordered.
+///
+/// Synopsis
+/// --------
+///
+///     template<int... Is, class F>
+///     constexpr permute_adaptor<F, Is...> permute(F f);
+///
+///     template<int... Is, class F>
+///     constexpr select_adaptor<F, Is...> select(F f);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     int r = fit::permute<1, 0>(fit::_ - fit::_)(2, 5);
+///     assert(r == 3);
+///     int s = fit::select<1, 1>(fit::_ * fit::_)(2, 5);
+///     assert(s == 25);
+///
+
+#include <tuple>
+#include <type_traits>
+#include <fit/args.h>
+#include <fit/detail/and.h>
+#include <fit/detail/result_of.h>
+#include <fit/reveal.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+
+namespace fit {
+
+namespace detail {
+
+template<int K>
+constexpr int index_count()
+{
+    return 0;
+}
+
+template<int K, int I, int... Is>
+constexpr int index_count()
+{
+    return (K == I ? 1 : 0) + index_count<K, Is...>();
+}
+
+template<int... Is>
+struct index_max;
+
+template<>
+struct index_max<>
+: std::integral_constant<int, -1>
+{};
+
+template<int I, int... Is>
+struct index_max<I, Is...>
+: std::integral_constant<int, (I > index_max<Is...>::value ? I : index_max<Is...>::value)>
+{};
+
+template<int N, int... Is>
+struct is_permutation
+: and_<std::integral_constant<bool, (Is >= 0 && Is < N && index_count<Is, Is...>() == 1)>...>
+{};
+
+// The type of the parameter passed for index I, which is an lvalue when the
+// index is used more than once
+template<int I, bool Unique, class... Ts>
+struct select_type
+{
+    typedef typename std::tuple_element<I, std::tuple<Ts...>>::type type;
+};
+
+template<int I, class... Ts>
+struct select_type<I, false, Ts...>
+{
+    typedef typename std::remove_reference<typename std::tuple_element<I, std::tuple<Ts...>>::type>::type& type;
+};
+
+template<int I, bool Unique>
+struct select_arg
+{
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (detail::get_args<I+1>(fit::forward<Ts>(xs)...));
+};
+
+template<int I>
+struct select_arg<I, false>
+{
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (detail::get_args<I+1>(xs...));
+};
+
+}
+
+template<class F, int... Is>
+struct select_adaptor : F
+{
+    static_assert(detail::and_<std::integral_constant<bool, (Is >= 0)>...>::value, "Indices must not be negative");
+
+    FIT_INHERIT_CONSTRUCTOR(select_adaptor, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    struct select_failure
+    {
+        template<class Failure>
+        struct apply
+        {
+            template<class... Ts>
+            struct of
+            : Failure::template of<typename detail::select_type<Is, (detail::index_count<Is, Is...>() == 1), Ts...>::type...>
+            {};
+        };
+    };
+
+    struct failure
+    : failure_map<select_failure, F>
+    {};
+
+    FIT_RETURNS_CLASS(select_adaptor);
+
+    template<class... Ts, typename std::enable_if<(
+        detail::index_max<Is...>::value < int(sizeof...(Ts))
+    ), int>::type = 0>
+    constexpr FIT_SFINAE_RESULT(const F&, id_<typename detail::select_type<Is, (detail::index_count<Is, Is...>() == 1), Ts...>::type>...)
+    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        (FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->base_function(xs...)))
+            (detail::select_arg<Is, (detail::index_count<Is, Is...>() == 1)>()(fit::forward<Ts>(xs)...)...)
+    );
+};
+
+template<class F, int... Is>
+struct permute_adaptor : F
+{
+    static_assert(detail::is_permutation<sizeof...(Is), Is...>::value, "Indices must be a permutation");
+
+    FIT_INHERIT_CONSTRUCTOR(permute_adaptor, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    struct permute_failure
+    {
+        template<class Failure>
+        struct apply
+        {
+            template<class... Ts>
+            struct of
+            : Failure::template of<typename std::tuple_element<Is, std::tuple<Ts...>>::type...>
+            {};
+        };
+    };
+
+    struct failure
+    : failure_map<permute_failure, F>
+    {};
+
+    FIT_RETURNS_CLASS(permute_adaptor);
+
+    template<class... Ts, typename std::enable_if<(sizeof...(Ts) == sizeof...(Is)), int>::type = 0>
+    constexpr FIT_SFINAE_RESULT(const F&, id_<typename std::tuple_element<Is, std::tuple<Ts...>>::type>...)
+    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        (FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->base_function(xs...)))
+            (detail::get_args<Is+1>(fit::forward<Ts>(xs)...)...)
+    );
+};
+
+template<int... Is, class F>
+constexpr permute_adaptor<F, Is...> permute(F f)
+{
+    return permute_adaptor<F, Is...>(fit::move(f));
+}
+
+template<int... Is, class F>
+constexpr select_adaptor<F, Is...> select(F f)
+{
+    return select_adaptor<F, Is...>(fit::move(f));
+}
+
+}
+
+#endif
@@ -19,12 +19,27 @@
 /// `|` operator. This can be especially convenient when there are a lot of
 /// nested function calls. Functions that are made pipable can still be called
 /// the traditional way without piping in the first parameter.
-/// 
+///
+/// Each `|` calls the function right away, so `x | f(a) | g(b) | h(c)` is
+/// evaluated one call at a time. The `pipe_chain` function collects partially
+/// applied functions into a chain without calling anything, as in
+/// `x | pipe_chain(f(a), g(b), h(c))`. When a value is piped into the chain,
+/// or the chain is called with it, the stages are called in order as one
+/// `flow`. The chain holds copies of the functions and of their arguments,
+/// like `pack_decay`, so it can be stored and used later. A chain can also be
+/// a stage of another chain.
+///
+/// Piping one partially applied function into another, as in `f(a) | g(b)`,
+/// passes the first one as the first argument of `g`, like any other value.
+///
 /// Synopsis
 /// --------
 /// 
 ///     template<class F>
 ///     constexpr pipable_adaptor<F> pipable(F f);
+///
+///     template<class... Ts>
+///     constexpr auto pipe_chain(Ts&&... fs);
 /// 
 /// Requirements
 /// ------------
@@ -48,9 +63,11 @@
 /// 
 ///     assert(3 == 1 | pipable(sum())(2));
 ///     assert(3 == pipable(sum())(1, 2));
+///     assert(6 == 1 | pipe_chain(pipable(sum())(2), pipable(sum())(3)));
 /// 
 
 #include <fit/conditional.h>
+#include <fit/flow.h>
 #include <fit/pack.h>
 #include <fit/detail/delegate.h>
 #include <fit/detail/move.h>
@@ -84,13 +101,15 @@ struct pipe_closure : F, Pack
         return *this;
     }
 
+    // Holds the function itself rather than a pointer to the closure, so the
+    // closure doesn't have to stay in memory while the function is called
     template<class A>
     struct invoke
     {
         A a;
-        const pipe_closure * self;
+        const F& f;
         template<class X>
-        constexpr invoke(X&& x, const pipe_closure * self) : a(fit::forward<X>(x)), self(self)
+        constexpr invoke(X&& x, const F& f) : a(fit::forward<X>(x)), f(f)
         {}
 
         FIT_RETURNS_CLASS(invoke);
@@ -98,7 +117,7 @@ struct pipe_closure : F, Pack
         template<class... Ts>
         constexpr FIT_SFINAE_RESULT(const F&, id_<A>, id_<Ts>...) 
         operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
-        (FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->self->base_function(xs...))(fit::forward<A>(a), fit::forward<Ts>(xs)...));
+        (FIT_MANGLE_CAST(const F&)(FIT_CONST_THIS->f)(fit::forward<A>(a), fit::forward<Ts>(xs)...));
     };
 
     FIT_RETURNS_CLASS(pipe_closure);
@@ -106,7 +125,7 @@ struct pipe_closure : F, Pack
     template<class A>
     constexpr FIT_SFINAE_RESULT(const Pack&, id_<invoke<A&&>>) 
     operator()(A&& a) const FIT_SFINAE_RETURNS
-    (FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(a))(invoke<A&&>(fit::forward<A>(a), FIT_CONST_THIS)));
+    (FIT_MANGLE_CAST(const Pack&)(FIT_CONST_THIS->get_pack(a))(invoke<A&&>(fit::forward<A>(a), FIT_CONST_THIS->base_function(a))));
 };
 
 template<class F, class Pack>
@@ -132,10 +151,115 @@ struct pipe_pack
     (make_pipe_closure(FIT_RETURNS_C_CAST(F&&)(FIT_CONST_THIS->get_function(xs...)), fit::pack_forward(fit::forward<Ts>(xs)...)));
 };
     
+// A stage of a chain holds copies of the arguments, since the partially
+// applied function only refers to them. It passes them straight to the
+// function, rather than through a pack and an invoke object.
+template<class F, class Seq, class... Ts>
+struct pipe_stage;
+
+template<class F, int... Ns, class... Ts>
+struct pipe_stage<F, seq<Ns...>, Ts...>
+: F, pack_base<seq<Ns...>, Ts...>
+{
+    typedef pack_base<seq<Ns...>, Ts...> base;
+
+    template<class X, class... Xs, typename std::enable_if<(sizeof...(Xs) == sizeof...(Ts)), int>::type = 0>
+    constexpr pipe_stage(X&& f, Xs&&... xs) : F(fit::forward<X>(f)), base(fit::forward<Xs>(xs)...)
+    {}
+
+    template<class... Xs>
+    constexpr const F& base_function(Xs&&...) const
+    {
+        return *this;
+    }
+
+    FIT_RETURNS_CLASS(pipe_stage);
+
+    template<class A>
+    constexpr auto operator()(A&& a) const FIT_RETURNS
+    (
+        FIT_CONST_THIS->base_function(a)(fit::forward<A>(a), 
+            alias_value<pack_tag<seq<Ns>, Ts...>, Ts>(static_cast<const base&>(*FIT_CONST_THIS))...)
+    );
+};
+
+template<class F>
+struct pipe_stage_construct
+{
+    F& f;
+
+    template<class... Ts>
+    constexpr pipe_stage<F, typename gens<sizeof...(Ts)>::type, typename std::decay<Ts>::type...> 
+    operator()(Ts&&... xs) const
+    {
+        return pipe_stage<F, typename gens<sizeof...(Ts)>::type, typename std::decay<Ts>::type...>(
+            fit::move(f), fit::forward<Ts>(xs)...);
+    }
+};
+
+template<class F, class Pack>
+constexpr auto make_pipe_stage_from(F f, Pack&& p) FIT_RETURNS
+(
+    unpack_pack_base(pipe_stage_construct<F>{f}, fit::forward<Pack>(p))
+);
+
+template<class F, class Pack>
+constexpr auto make_pipe_stage(const pipe_closure<F, Pack>& p) FIT_RETURNS
+(
+    make_pipe_stage_from(p.base_function(), p.get_pack())
+);
+
+template<class F, class Pack>
+constexpr auto make_pipe_stage(pipe_closure<F, Pack>&& p) FIT_RETURNS
+(
+    make_pipe_stage_from(static_cast<F&&>(p), static_cast<Pack&&>(p))
+);
+
+template<class... Stages>
+struct pipe_chain_adaptor;
+
+// A chain is used as a single stage of a longer chain
+template<class... Stages>
+constexpr pipe_chain_adaptor<Stages...> make_pipe_stage(const pipe_chain_adaptor<Stages...>& chain)
+{
+    return chain;
+}
+
+template<class... Stages>
+constexpr pipe_chain_adaptor<Stages...> make_pipe_stage(pipe_chain_adaptor<Stages...>&& chain)
+{
+    return fit::move(chain);
+}
+
+template<class... Stages>
+struct pipe_chain_adaptor : flow_adaptor<Stages...>
+{
+    typedef flow_adaptor<Stages...> base;
+
+    FIT_INHERIT_CONSTRUCTOR(pipe_chain_adaptor, base);
+};
+
+template<class... Stages>
+constexpr pipe_chain_adaptor<Stages...> make_pipe_chain(Stages... stages)
+{
+    return pipe_chain_adaptor<Stages...>(fit::move(stages)...);
+}
+
+struct pipe_chain_f
+{
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (make_pipe_chain(make_pipe_stage(fit::forward<Ts>(xs))...));
+};
+
 template<class A, class F, class Pack>
 constexpr auto operator|(A&& a, const pipe_closure<F, Pack>& p) FIT_RETURNS
 (p(fit::forward<A>(a)));
 
+template<class A, class... Stages>
+constexpr auto operator|(A&& a, const pipe_chain_adaptor<Stages...>& p) FIT_RETURNS
+(p(fit::forward<A>(a)));
+
 }
 
 template<class F>
@@ -159,6 +283,8 @@ constexpr auto operator|(A&& a, const pipable_adaptor<F>& p) FIT_RETURNS
 
 FIT_DECLARE_STATIC_VAR(pipable, detail::make<pipable_adaptor>);
 
+FIT_DECLARE_STATIC_VAR(pipe_chain, detail::pipe_chain_f);
+
 namespace detail {
 
 template<class F>
@@ -0,0 +1,443 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    pipeline.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PIPELINE_H
+#define FIT_GUARD_PIPELINE_H
+
+/// pipeline
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `pipeline` function adaptor composes functions like `flow`, and
+/// calling it with a single value is the same as calling `flow`. The `run`
+/// member function takes a stream of values from an input range instead. It
+/// runs every stage on its own thread, and writes `flow(fs...)(x)` to the
+/// output iterator for each `x`, in order. Only the last stage runs on the
+/// calling thread, so the output iterator is only used from that thread. When
+/// the stages take about the same time, the number of values processed per
+/// second approaches that of the slowest stage, rather than that of all
+/// stages combined.
+///
+/// Each stage is connected to the next by a bounded lock-free
+/// single-producer single-consumer queue holding `FIT_PIPELINE_CAPACITY`
+/// values, which must be a power of two. The producer makes each value
+/// visible to the consumer as soon as it is pushed, so a value never waits
+/// for the rest of a batch. The consumer frees space in the queue in batches
+/// of `FIT_PIPELINE_BATCH` values, or sooner when it runs dry. A stage waits
+/// when the queue to the next stage is full, so a slow stage holds back the
+/// stages before it. A stage with nothing to do blocks on a condition
+/// variable rather than spinning.
+///
+/// If a stage throws, the stages stop early, and `run` rethrows the exception
+/// thrown by the earliest stage after every thread has finished.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Fs>
+///     constexpr pipeline_adaptor<Fs...> pipeline(Fs... fs);
+///
+///     template<class... Fs>
+///     struct pipeline_adaptor
+///     {
+///         template<class InputIterator, class OutputIterator>
+///         OutputIterator run(InputIterator first, InputIterator last, OutputIterator out) const;
+///     };
+///
+/// Requirements
+/// ------------
+///
+/// Fs must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     std::vector<std::string> lines = read_lines();
+///     std::vector<std::string> out;
+///     fit::pipeline(parse(), transform(), serialize())
+///         .run(lines.begin(), lines.end(), std::back_inserter(out));
+///
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <thread>
+#include <type_traits>
+#include <fit/flow.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/make.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+#ifndef FIT_PIPELINE_CAPACITY
+#define FIT_PIPELINE_CAPACITY 1024
+#endif
+
+#ifndef FIT_PIPELINE_BATCH
+#define FIT_PIPELINE_BATCH 64
+#endif
+
+namespace fit {
+
+namespace detail {
+
+static_assert((FIT_PIPELINE_CAPACITY & (FIT_PIPELINE_CAPACITY - 1)) == 0,
+    "FIT_PIPELINE_CAPACITY must be a power of two");
+
+struct pipeline_control
+{
+    std::mutex m;
+    std::exception_ptr error;
+    int error_stage;
+
+    pipeline_control() : error_stage(0)
+    {}
+
+    // Must be called from a catch block
+    void fail(int stage)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (!error || stage < error_stage)
+        {
+            error = std::current_exception();
+            error_stage = stage;
+        }
+    }
+
+    void rethrow()
+    {
+        if (error) std::rethrow_exception(error);
+    }
+};
+
+// The producer and consumer each keep their own position, along with the
+// last position of the other side they have seen, on separate cache lines.
+// The shared positions are only read when the cached one runs out. The
+// producer writes its position for every value, and the consumer once per
+// batch, or sooner when the producer is waiting. A side with nothing to do
+// blocks on a condition variable, after setting its waiting flag. Each side
+// stores its position before it reads the other side's flag, and the waiting
+// side sets its flag before it reads the position, so one of them always
+// sees the other. The side that sees the flag clears it, so it only wakes
+// the other side once.
+template<class T>
+class spsc_queue
+{
+    typedef typename std::aligned_storage<sizeof(T), std::alignment_of<T>::value>::type storage_type;
+    static constexpr std::size_t capacity = FIT_PIPELINE_CAPACITY;
+    static constexpr std::size_t batch = FIT_PIPELINE_BATCH < capacity ? FIT_PIPELINE_BATCH : capacity;
+
+    std::unique_ptr<storage_type[]> buffer;
+    std::mutex m;
+    std::condition_variable not_empty;
+    std::condition_variable not_full;
+    std::atomic<bool> closed;
+    std::atomic<bool> stopped;
+    alignas(64) std::atomic<std::size_t> head;
+    std::atomic<bool> consumer_waiting;
+    alignas(64) std::atomic<std::size_t> tail;
+    std::atomic<bool> producer_waiting;
+    alignas(64) std::size_t write;
+    std::size_t cached_head;
+    alignas(64) std::size_t read;
+    std::size_t cached_tail;
+
+    T* slot(std::size_t i)
+    {
+        return reinterpret_cast<T*>(&buffer[i & (capacity - 1)]);
+    }
+
+    void notify(std::condition_variable& cv)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+        }
+        cv.notify_one();
+    }
+
+    void release()
+    {
+        head.store(read);
+        if (producer_waiting.load() && producer_waiting.exchange(false)) this->notify(not_full);
+    }
+
+    void publish()
+    {
+        tail.store(write);
+        if (consumer_waiting.load() && consumer_waiting.exchange(false)) this->notify(not_empty);
+    }
+
+    template<class F>
+    bool consume_until_closed(F& f)
+    {
+        for(;;)
+        {
+            if (read == cached_tail)
+            {
+                this->release();
+                cached_tail = tail.load(std::memory_order_acquire);
+                if (read == cached_tail)
+                {
+                    std::unique_lock<std::mutex> lock(m);
+                    not_empty.wait(lock, [this]
+                    {
+                        consumer_waiting.store(true);
+                        cached_tail = tail.load();
+                        return read != cached_tail || closed.load();
+                    });
+                    consumer_waiting.store(false, std::memory_order_relaxed);
+                    if (read == cached_tail) return true;
+                }
+            }
+            T* p = slot(read);
+            bool more = f(fit::move(*p));
+            p->~T();
+            read++;
+            if (!more) return false;
+            if (read - head.load(std::memory_order_relaxed) >= batch && 
+                producer_waiting.load(std::memory_order_relaxed)) this->release();
+        }
+    }
+public:
+    spsc_queue()
+    : buffer(new storage_type[capacity]), closed(false), stopped(false),
+      head(0), consumer_waiting(false), tail(0), producer_waiting(false),
+      write(0), cached_head(0), read(0), cached_tail(0)
+    {}
+
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+
+    ~spsc_queue()
+    {
+        for(; read != write; read++) slot(read)->~T();
+    }
+
+    // Returns false if the consumer stopped early
+    template<class X>
+    bool push(X&& x)
+    {
+        if (write - cached_head == capacity)
+        {
+            cached_head = head.load(std::memory_order_acquire);
+            if (write - cached_head == capacity)
+            {
+                std::unique_lock<std::mutex> lock(m);
+                not_full.wait(lock, [this]
+                {
+                    producer_waiting.store(true);
+                    cached_head = head.load();
+                    return write - cached_head < capacity || stopped.load();
+                });
+                producer_waiting.store(false, std::memory_order_relaxed);
+            }
+        }
+        if (stopped.load(std::memory_order_relaxed)) return false;
+        new (slot(write)) T(fit::forward<X>(x));
+        write++;
+        this->publish();
+        return true;
+    }
+
+    void close()
+    {
+        tail.store(write);
+        {
+            std::lock_guard<std::mutex> lock(m);
+            closed.store(true);
+        }
+        not_empty.notify_one();
+    }
+
+    // Stops the consumer early, so a waiting or later push returns false
+    void stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopped.store(true);
+        }
+        not_full.notify_one();
+    }
+
+    // Calls f with each value until the queue is closed, or f returns false
+    template<class F>
+    void consume(F f)
+    {
+        bool closed_and_empty = false;
+        try
+        {
+            closed_and_empty = this->consume_until_closed(f);
+        }
+        catch(...)
+        {
+            this->stop();
+            throw;
+        }
+        if (!closed_and_empty) this->stop();
+    }
+};
+
+template<class F, class T>
+struct pipeline_stage_result
+{
+    typedef typename std::decay<decltype(std::declval<const F&>()(std::declval<T>()))>::type type;
+};
+
+template<class F, class OutputIterator>
+struct pipeline_output
+{
+    const F& f;
+    OutputIterator& out;
+    pipeline_control& c;
+    int stage;
+
+    template<class T>
+    bool operator()(T&& x) const
+    {
+        try
+        {
+            *out = f(fit::forward<T>(x));
+            ++out;
+            return true;
+        }
+        catch(...)
+        {
+            c.fail(stage);
+            return false;
+        }
+    }
+};
+
+template<class F, class T>
+struct pipeline_push
+{
+    const F& f;
+    spsc_queue<T>& q;
+
+    template<class X>
+    bool operator()(X&& x) const
+    {
+        return q.push(f(fit::forward<X>(x)));
+    }
+};
+
+// Runs the stages after the first one, reading the values from the queue
+template<class F, class In, class OutputIterator>
+void pipeline_drain(const flow_adaptor<F>& f, spsc_queue<In>& in, OutputIterator& out, pipeline_control& c, int stage)
+{
+    in.consume(pipeline_output<F, OutputIterator>{f, out, c, stage});
+}
+
+template<class F, class... Fs, class In, class OutputIterator>
+void pipeline_drain(const flow_adaptor<F, Fs...>& f, spsc_queue<In>& in, OutputIterator& out, pipeline_control& c, int stage)
+{
+    typedef typename pipeline_stage_result<F, In&&>::type T;
+    spsc_queue<T> q;
+    std::thread t;
+    try
+    {
+        t = std::thread([&]
+        {
+            try
+            {
+                in.consume(pipeline_push<F, T>{f.first(), q});
+            }
+            catch(...)
+            {
+                c.fail(stage);
+            }
+            q.close();
+        });
+    }
+    catch(...)
+    {
+        c.fail(stage);
+        // Nothing will read from the queue, so the stage before must not
+        // wait for space in it
+        in.stop();
+        return;
+    }
+    pipeline_drain(f.second(), q, out, c, stage+1);
+    t.join();
+}
+
+template<class F, class InputIterator, class OutputIterator>
+void pipeline_start(const flow_adaptor<F>& f, InputIterator first, InputIterator last, OutputIterator& out, pipeline_control& c)
+{
+    pipeline_output<F, OutputIterator> output{f, out, c, 0};
+    for(; first != last; ++first)
+    {
+        if (!output(*first)) return;
+    }
+}
+
+template<class F, class... Fs, class InputIterator, class OutputIterator>
+void pipeline_start(const flow_adaptor<F, Fs...>& f, InputIterator first, InputIterator last, OutputIterator& out, pipeline_control& c)
+{
+    typedef typename pipeline_stage_result<F, decltype(*first)>::type T;
+    spsc_queue<T> q;
+    std::thread t;
+    try
+    {
+        t = std::thread([&]
+        {
+            try
+            {
+                for(; first != last; ++first)
+                {
+                    if (!q.push(f.first()(*first))) break;
+                }
+            }
+            catch(...)
+            {
+                c.fail(0);
+            }
+            q.close();
+        });
+    }
+    catch(...)
+    {
+        c.fail(0);
+        return;
+    }
+    pipeline_drain(f.second(), q, out, c, 1);
+    t.join();
+}
+
+}
+
+template<class... Fs>
+struct pipeline_adaptor : flow_adaptor<Fs...>
+{
+    typedef pipeline_adaptor fit_rewritable_tag;
+    typedef flow_adaptor<Fs...> base;
+    FIT_INHERIT_CONSTRUCTOR(pipeline_adaptor, base)
+
+    template<class InputIterator, class OutputIterator>
+    OutputIterator run(InputIterator first, InputIterator last, OutputIterator out) const
+    {
+        detail::pipeline_control c;
+        detail::pipeline_start(static_cast<const base&>(*this), first, last, out, c);
+        c.rethrow();
+        return out;
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(pipeline, detail::make<pipeline_adaptor>);
+
+}
+
+#endif
@@ -0,0 +1,342 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    profile.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PROFILE_H
+#define FIT_GUARD_PROFILE_H
+
+/// profile
+/// =======
+///
+/// Description
+/// -----------
+///
+/// The `profile` function adaptor records how long each call to a function
+/// takes, under the given name. For each name, it keeps the number of calls,
+/// the total and the maximum time spent in the calls, and a histogram of the
+/// times. Bucket `i` of the histogram counts the calls that took between
+/// `2^(i-1)` and `2^i` nanoseconds, and bucket `0` counts the calls that took
+/// less than a nanosecond. Functions that are profiled with the same name
+/// are recorded together. Calls that throw are recorded too.
+///
+/// Each thread records its calls into its own counters, so calls on
+/// different threads don't contend with each other. The counters for every
+/// thread are added together when they are read with `profile_report`, or
+/// written out with `profile_dump_text` or `profile_dump_json`.
+///
+/// Profiling can be turned off by defining `FIT_PROFILE` to `0`. Then
+/// `profile` just returns the function it was given, so it adds no cost at
+/// all, and the reports are empty.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     profile_adaptor<F> profile(const char* name, F f);
+///
+///     struct profile_stats
+///     {
+///         std::string name;
+///         std::uint64_t count;
+///         std::uint64_t total_ns;
+///         std::uint64_t max_ns;
+///         std::uint64_t histogram[64];
+///     };
+///
+///     std::vector<profile_stats> profile_report();
+///
+///     void profile_dump_text(std::ostream& os);
+///
+///     void profile_dump_json(std::ostream& os);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     auto parse = fit::profile("parse", parse_f());
+///     for(auto&& line:lines) parse(line);
+///     fit::profile_dump_text(std::cout);
+///
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+#include <fit/detail/json.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+#ifndef FIT_PROFILE
+#define FIT_PROFILE 1
+#endif
+
+#if FIT_PROFILE
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <fit/always.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/forward.h>
+#endif
+
+namespace fit {
+
+struct profile_stats
+{
+    std::string name;
+    std::uint64_t count;
+    std::uint64_t total_ns;
+    std::uint64_t max_ns;
+    std::uint64_t histogram[64];
+};
+
+#if FIT_PROFILE
+
+namespace detail {
+
+// Only the owning thread writes to the counters, so they are updated with
+// plain loads and stores rather than read-modify-write operations. The
+// atomics are only there so they can be read from other threads.
+struct profile_counters
+{
+    std::atomic<std::uint64_t> count;
+    std::atomic<std::uint64_t> total_ns;
+    std::atomic<std::uint64_t> max_ns;
+    std::atomic<std::uint64_t> histogram[64];
+
+    profile_counters() : count(0), total_ns(0), max_ns(0)
+    {
+        for(std::atomic<std::uint64_t>& h:histogram) h.store(0);
+    }
+
+    static void add(std::atomic<std::uint64_t>& x, std::uint64_t n)
+    {
+        x.store(x.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+    }
+
+    static std::size_t bucket(std::uint64_t ns)
+    {
+        std::size_t i = 0;
+        for(; ns > 0; ns >>= 1) i++;
+        return i < 64 ? i : 63;
+    }
+
+    void record(std::uint64_t ns)
+    {
+        add(count, 1);
+        add(total_ns, ns);
+        if (ns > max_ns.load(std::memory_order_relaxed)) max_ns.store(ns, std::memory_order_relaxed);
+        add(histogram[bucket(ns)], 1);
+    }
+};
+
+struct profile_entry
+{
+    std::string name;
+    std::size_t id;
+    std::vector<std::unique_ptr<profile_counters>> threads;
+};
+
+class profile_registry
+{
+    std::mutex m;
+    std::map<std::string, std::unique_ptr<profile_entry>> entries;
+public:
+    static profile_registry& instance()
+    {
+        static profile_registry r;
+        return r;
+    }
+
+    profile_entry* get(const char* name)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        std::unique_ptr<profile_entry>& e = entries[name];
+        if (!e)
+        {
+            e.reset(new profile_entry());
+            e->name = name;
+            e->id = entries.size() - 1;
+        }
+        return e.get();
+    }
+
+    profile_counters* add_thread(profile_entry* e)
+    {
+        std::lock_guard<std::mutex> lock(m);
+        e->threads.emplace_back(new profile_counters());
+        return e->threads.back().get();
+    }
+
+    std::vector<profile_stats> report()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        std::vector<profile_stats> result;
+        for(auto&& p:entries)
+        {
+            profile_stats s = {};
+            s.name = p.first;
+            for(auto&& c:p.second->threads)
+            {
+                s.count += c->count.load(std::memory_order_relaxed);
+                s.total_ns += c->total_ns.load(std::memory_order_relaxed);
+                std::uint64_t max_ns = c->max_ns.load(std::memory_order_relaxed);
+                if (max_ns > s.max_ns) s.max_ns = max_ns;
+                for(std::size_t i = 0; i < 64; i++) s.histogram[i] += c->histogram[i].load(std::memory_order_relaxed);
+            }
+            result.push_back(s);
+        }
+        return result;
+    }
+};
+
+// Each thread keeps its counters for every entry in a table indexed by the
+// id of the entry, so finding them doesn't need a lock
+inline profile_counters& profile_thread_counters(profile_entry* e)
+{
+    static thread_local std::vector<profile_counters*> table;
+    if (e->id >= table.size()) table.resize(e->id + 1, nullptr);
+    profile_counters*& c = table[e->id];
+    if (c == nullptr) c = profile_registry::instance().add_thread(e);
+    return *c;
+}
+
+struct profile_timer
+{
+    profile_entry* e;
+    std::chrono::steady_clock::time_point start;
+
+    explicit profile_timer(profile_entry* e) : e(e), start(std::chrono::steady_clock::now())
+    {}
+
+    ~profile_timer()
+    {
+        std::chrono::steady_clock::duration d = std::chrono::steady_clock::now() - start;
+        profile_thread_counters(e).record(std::chrono::duration_cast<std::chrono::nanoseconds>(d).count());
+    }
+};
+
+}
+
+template<class F>
+struct profile_adaptor : F
+{
+    detail::profile_entry* entry;
+
+    template<class X>
+    profile_adaptor(const char* name, X&& x)
+    : F(fit::forward<X>(x)), entry(detail::profile_registry::instance().get(name))
+    {}
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts, class R=decltype(std::declval<const F&>()(std::declval<Ts>()...))>
+    R operator()(Ts&&... xs) const
+    {
+        detail::profile_timer timer(entry);
+        return this->base_function(xs...)(fit::forward<Ts>(xs)...);
+    }
+};
+
+namespace detail {
+
+struct profile_f
+{
+    template<class F>
+    profile_adaptor<F> operator()(const char* name, F f) const
+    {
+        return profile_adaptor<F>(name, fit::move(f));
+    }
+};
+
+}
+
+inline std::vector<profile_stats> profile_report()
+{
+    return detail::profile_registry::instance().report();
+}
+
+#else
+
+namespace detail {
+
+struct profile_f
+{
+    template<class F>
+    constexpr F operator()(const char*, F f) const
+    {
+        return f;
+    }
+};
+
+}
+
+inline std::vector<profile_stats> profile_report()
+{
+    return {};
+}
+
+#endif
+
+FIT_DECLARE_STATIC_VAR(profile, detail::profile_f);
+
+inline void profile_dump_text(std::ostream& os)
+{
+    for(const profile_stats& s:profile_report())
+    {
+        os << s.name
+            << ": count=" << s.count
+            << " total_ns=" << s.total_ns
+            << " mean_ns=" << (s.count > 0 ? s.total_ns / s.count : 0)
+            << " max_ns=" << s.max_ns
+            << '\n';
+    }
+}
+
+inline void profile_dump_json(std::ostream& os)
+{
+    os << '[';
+    bool first = true;
+    for(const profile_stats& s:profile_report())
+    {
+        if (!first) os << ',';
+        first = false;
+        os << "{\"name\":";
+        detail::json_write_string(os, s.name.data(), s.name.data() + s.name.size());
+        os << ",\"count\":" << s.count
+            << ",\"total_ns\":" << s.total_ns
+            << ",\"max_ns\":" << s.max_ns
+            << ",\"histogram\":[";
+        std::size_t n = 64;
+        while (n > 0 && s.histogram[n-1] == 0) n--;
+        for(std::size_t i = 0; i < n; i++)
+        {
+            if (i > 0) os << ',';
+            os << s.histogram[i];
+        }
+        os << "]}";
+    }
+    os << ']';
+}
+
+}
+
+#endif
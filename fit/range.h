@@ -0,0 +1,352 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    range.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_RANGE_H
+#define FIT_GUARD_RANGE_H
+
+/// range
+/// =====
+///
+/// Description
+/// -----------
+///
+/// The range adaptors `transform`, `filter` and `take` are stages that are
+/// chained onto a range with the pipe operator `|`, and `fold` reduces the
+/// values that come out of them to a single result. Nothing happens until
+/// the `fold` is applied. Then all the stages run in one loop over the range:
+/// each value is passed through every stage before the next value is read.
+/// So there are no intermediate containers, and since each stage is a
+/// concrete type rather than a type-erased function, the stages are inlined
+/// into the body of the loop, which the compiler can then vectorize.
+///
+/// * `transform(f)` passes on `f(x)` for each value `x`.
+/// * `filter(p)` passes on only the values for which `p(x)` is true.
+/// * `take(n)` passes on the first `n` values, and then stops the loop.
+/// * `fold(f, init)` starts with `init`, and replaces it with `f(result, x)`
+///   for each value `x`.
+///
+/// The range can be anything that works with a range-based for loop. It is
+/// stored by reference when it is an lvalue, and moved into the pipeline
+/// otherwise. Stages can also be piped into each other, without a range, to
+/// make a reusable stage.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     constexpr range_transform<F> transform(F f);
+///
+///     template<class F>
+///     constexpr range_filter<F> filter(F p);
+///
+///     constexpr range_take take(std::size_t n);
+///
+///     template<class F, class T>
+///     constexpr range_fold<F, T> fold(F f, T init);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     std::vector<int> v = {1, 2, 3, 4, 5, 6};
+///     int r = v
+///         | fit::filter([](int x) { return x % 2 == 0; })
+///         | fit::transform(fit::_1 * fit::_1)
+///         | fit::take(2)
+///         | fit::fold(fit::_1 + fit::_2, 0);
+///     assert(r == 4 + 16);
+///
+
+#include <cstddef>
+#include <type_traits>
+#include <fit/always.h>
+#include <fit/detail/compressed_pair.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/forward.h>
+#include <fit/detail/make.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class F, class Sink>
+struct range_transform_sink
+{
+    const F& f;
+    Sink next;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        return next(f(fit::forward<T>(x)));
+    }
+};
+
+template<class F, class Sink>
+struct range_filter_sink
+{
+    const F& p;
+    Sink next;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        return p(x) ? next(fit::forward<T>(x)) : true;
+    }
+};
+
+template<class Sink>
+struct range_take_sink
+{
+    std::size_t n;
+    Sink next;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        if (n == 0) return false;
+        return next(fit::forward<T>(x)) && --n > 0;
+    }
+};
+
+template<class F, class T>
+struct range_fold_sink
+{
+    const F& f;
+    T& result;
+
+    template<class X>
+    bool operator()(X&& x)
+    {
+        result = f(fit::move(result), fit::forward<X>(x));
+        return true;
+    }
+};
+
+struct range_identity_stage
+{
+    template<class Sink>
+    Sink sink(Sink next) const
+    {
+        return next;
+    }
+};
+
+template<class R, class Sink>
+void range_run(R&& r, Sink s)
+{
+    for(auto&& x:r)
+    {
+        if (!s(fit::forward<decltype(x)>(x))) break;
+    }
+}
+
+}
+
+template<class F>
+struct range_transform : F
+{
+    FIT_INHERIT_CONSTRUCTOR(range_transform, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class Sink>
+    detail::range_transform_sink<F, Sink> sink(Sink next) const
+    {
+        return {this->base_function(next), fit::move(next)};
+    }
+};
+
+template<class F>
+struct range_filter : F
+{
+    FIT_INHERIT_CONSTRUCTOR(range_filter, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class Sink>
+    detail::range_filter_sink<F, Sink> sink(Sink next) const
+    {
+        return {this->base_function(next), fit::move(next)};
+    }
+};
+
+struct range_take
+{
+    std::size_t n;
+
+    constexpr range_take(std::size_t n) : n(n)
+    {}
+
+    template<class Sink>
+    detail::range_take_sink<Sink> sink(Sink next) const
+    {
+        return {n, fit::move(next)};
+    }
+};
+
+template<class S1, class S2>
+struct range_compose
+: detail::compressed_pair<S1, S2>
+{
+    typedef detail::compressed_pair<S1, S2> base_type;
+    FIT_INHERIT_CONSTRUCTOR(range_compose, base_type)
+
+    template<class Sink>
+    auto sink(Sink next) const -> decltype(std::declval<const S1&>().sink(std::declval<const S2&>().sink(next)))
+    {
+        return this->first(next).sink(this->second(next).sink(fit::move(next)));
+    }
+};
+
+template<class R, class S>
+struct range_view
+{
+    R range;
+    S stage;
+};
+
+template<class F, class T>
+struct range_fold
+: detail::compressed_pair<F, T>
+{
+    typedef detail::compressed_pair<F, T> base_type;
+    FIT_INHERIT_CONSTRUCTOR(range_fold, base_type)
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class R, class Stage>
+    T apply(R&& r, const Stage& stage) const
+    {
+        T result = this->second(r);
+        detail::range_run(fit::forward<R>(r),
+            stage.sink(detail::range_fold_sink<F, T>{this->base_function(r), result}));
+        return result;
+    }
+};
+
+namespace detail {
+
+template<class T>
+struct is_range_stage_impl
+: std::false_type
+{};
+
+template<class F>
+struct is_range_stage_impl<range_transform<F>>
+: std::true_type
+{};
+
+template<class F>
+struct is_range_stage_impl<range_filter<F>>
+: std::true_type
+{};
+
+template<>
+struct is_range_stage_impl<range_take>
+: std::true_type
+{};
+
+template<class S1, class S2>
+struct is_range_stage_impl<range_compose<S1, S2>>
+: std::true_type
+{};
+
+template<class T>
+struct is_range_stage
+: is_range_stage_impl<typename std::decay<T>::type>
+{};
+
+template<class T>
+struct is_range_view
+: std::false_type
+{};
+
+template<class R, class S>
+struct is_range_view<range_view<R, S>>
+: std::true_type
+{};
+
+struct range_take_f
+{
+    constexpr range_take operator()(std::size_t n) const
+    {
+        return range_take(n);
+    }
+};
+
+}
+
+template<class S1, class S2, typename std::enable_if<(
+    detail::is_range_stage<S1>::value && detail::is_range_stage<S2>::value
+), int>::type = 0>
+range_compose<S1, S2> operator|(const S1& s1, const S2& s2)
+{
+    return range_compose<S1, S2>(s1, s2);
+}
+
+template<class R, class S, typename std::enable_if<(
+    detail::is_range_stage<S>::value &&
+    !detail::is_range_stage<R>::value &&
+    !detail::is_range_view<typename std::decay<R>::type>::value
+), int>::type = 0>
+range_view<R, S> operator|(R&& r, const S& s)
+{
+    return {fit::forward<R>(r), s};
+}
+
+template<class R, class S1, class S2, typename std::enable_if<(
+    detail::is_range_stage<S2>::value
+), int>::type = 0>
+range_view<R, range_compose<S1, S2>> operator|(range_view<R, S1> v, const S2& s)
+{
+    return {fit::forward<R>(v.range), range_compose<S1, S2>(fit::move(v.stage), s)};
+}
+
+template<class R, class F, class T, typename std::enable_if<(
+    !detail::is_range_view<typename std::decay<R>::type>::value
+), int>::type = 0>
+T operator|(R&& r, const range_fold<F, T>& f)
+{
+    return f.apply(fit::forward<R>(r), detail::range_identity_stage());
+}
+
+template<class R, class S, class F, class T>
+T operator|(const range_view<R, S>& v, const range_fold<F, T>& f)
+{
+    return f.apply(v.range, v.stage);
+}
+
+FIT_DECLARE_STATIC_VAR(transform, detail::make<range_transform>);
+FIT_DECLARE_STATIC_VAR(filter, detail::make<range_filter>);
+FIT_DECLARE_STATIC_VAR(take, detail::range_take_f);
+FIT_DECLARE_STATIC_VAR(fold, detail::make<range_fold>);
+
+}
+
+#endif
@@ -0,0 +1,398 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    reduce.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_REDUCE_H
+#define FIT_GUARD_REDUCE_H
+
+/// reduce
+/// ======
+///
+/// Description
+/// -----------
+///
+/// The `reduce` function folds the elements of a range with the function
+/// and initial state of a `compress` adaptor, and `transform_reduce` folds
+/// the results of the projection of a `by` adaptor with its function. Unlike
+/// calling the adaptors themselves, which fold a fixed list of arguments,
+/// these work on ranges whose length is only known at runtime, and fold
+/// them in parallel.
+///
+/// The range is split into chunks, which are folded as tasks on the
+/// `default_work_stealing_pool`, with the calling thread folding chunks
+/// too. Each chunk is folded starting from its first element. Then the
+/// results of the chunks are combined in pairs, like a balanced tree, and
+/// finally the initial state is combined with the total. So the function
+/// must be associative, and must be able to combine two results as well as
+/// a result and an element. Ranges that fit in one chunk, which holds
+/// `FIT_REDUCE_CHUNK_SIZE` elements, are folded on the calling thread.
+///
+/// By default, there are fewer and larger chunks when there are fewer
+/// threads, so with floating point numbers, the result can depend on the
+/// number of threads. Passing `reduce_order::deterministic` always uses
+/// chunks of `FIT_REDUCE_CHUNK_SIZE` elements, so the result is the same no
+/// matter how many threads there are or how the tasks are scheduled.
+///
+/// If there is no initial state, an empty range gives a value-initialized
+/// result. If any of the calls throw, the exception from the first chunk
+/// that threw is rethrown after every chunk has finished.
+///
+/// The `reduce_with` and `transform_reduce_with` functions take the executor
+/// to use as their first parameter. The executor's `size`, if it has one,
+/// is used as the number of threads, otherwise
+/// `std::thread::hardware_concurrency()` is.
+///
+/// Synopsis
+/// --------
+///
+///     enum class reduce_order { any, deterministic };
+///
+///     template<class Range, class F, class State>
+///     auto reduce(Range&& r, compress_adaptor<F, State> f, reduce_order order=reduce_order::any);
+///
+///     template<class Range, class Projection, class F>
+///     auto transform_reduce(Range&& r, by_adaptor<Projection, F> f, reduce_order order=reduce_order::any);
+///
+///     template<class Executor, class Range, class F, class State>
+///     auto reduce_with(Executor& e, Range&& r, compress_adaptor<F, State> f, reduce_order order=reduce_order::any);
+///
+///     template<class Executor, class Range, class Projection, class F>
+///     auto transform_reduce_with(Executor& e, Range&& r, by_adaptor<Projection, F> f, reduce_order order=reduce_order::any);
+///
+/// Requirements
+/// ------------
+///
+/// Range must have random access iterators.
+///
+/// For `reduce`, the elements of the range must be explicitly convertible to
+/// the type of the state, since each chunk starts from its first element.
+///
+/// F and Projection must be:
+///
+///     FunctionObject
+///
+/// They must also be safe to call from several threads at once.
+///
+/// Example
+/// -------
+///
+///     std::vector<double> v(1000000, 0.5);
+///     double sum = fit::reduce(v, fit::compress(fit::_ + fit::_, 0.0));
+///     assert(sum == 500000.0);
+///     double squares = fit::transform_reduce(v, fit::by(fit::_1 * fit::_1, fit::_ + fit::_),
+///         fit::reduce_order::deterministic);
+///
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+#include <fit/by.h>
+#include <fit/compress.h>
+#include <fit/parallel_apply_eval.h>
+#include <fit/thread_pool.h>
+#include <fit/detail/forward.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+#ifndef FIT_REDUCE_CHUNK_SIZE
+#define FIT_REDUCE_CHUNK_SIZE 4096
+#endif
+
+namespace fit {
+
+enum class reduce_order
+{
+    any,
+    deterministic
+};
+
+namespace detail {
+
+template<class Iterator, class R, class F>
+struct reduce_fold
+{
+    Iterator first;
+    const F& f;
+
+    R start(std::size_t i) const
+    {
+        return R(first[i]);
+    }
+
+    R step(R&& acc, std::size_t i) const
+    {
+        return f(fit::move(acc), first[i]);
+    }
+};
+
+template<class Iterator, class R, class Projection, class F>
+struct transform_reduce_fold
+{
+    Iterator first;
+    const Projection& p;
+    const F& f;
+
+    R start(std::size_t i) const
+    {
+        return p(first[i]);
+    }
+
+    R step(R&& acc, std::size_t i) const
+    {
+        return f(fit::move(acc), p(first[i]));
+    }
+};
+
+template<class R, class Fold>
+struct reduce_chunk
+{
+    const Fold& fold;
+    std::size_t first;
+    std::size_t last;
+
+    R operator()() const
+    {
+        R acc = fold.start(first);
+        for(std::size_t i = first + 1; i < last; i++) acc = fold.step(fit::move(acc), i);
+        return acc;
+    }
+};
+
+// The chunks are claimed in order from a shared counter, by the calling
+// thread and by any tasks that the executor has started
+template<class R, class Fold>
+struct reduce_state
+{
+    const Fold& fold;
+    std::size_t n;
+    std::size_t chunk_size;
+    std::size_t count;
+    std::unique_ptr<parallel_eval_slot<R>[]> results;
+    std::unique_ptr<std::exception_ptr[]> errors;
+    std::atomic<std::size_t> next;
+    std::size_t remaining;
+    std::mutex m;
+    std::condition_variable cv;
+
+    reduce_state(const Fold& fold, std::size_t n, std::size_t chunk_size)
+    : fold(fold), n(n), chunk_size(chunk_size), count((n + chunk_size - 1) / chunk_size),
+      results(new parallel_eval_slot<R>[count]), errors(new std::exception_ptr[count]),
+      next(0), remaining(count)
+    {}
+
+    void run()
+    {
+        for(;;)
+        {
+            std::size_t i = next++;
+            if (i >= count) return;
+            try
+            {
+                std::size_t last = (i + 1) * chunk_size;
+                results[i].set(reduce_chunk<R, Fold>{fold, i * chunk_size, last < n ? last : n});
+            }
+            catch(...)
+            {
+                errors[i] = std::current_exception();
+            }
+            std::lock_guard<std::mutex> lock(m);
+            if (--remaining == 0) cv.notify_all();
+        }
+    }
+
+    void wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [this] { return remaining == 0; });
+        for(std::size_t i = 0; i < count; i++)
+        {
+            if (errors[i]) std::rethrow_exception(errors[i]);
+        }
+    }
+};
+
+template<class State>
+struct reduce_task
+{
+    std::shared_ptr<State> state;
+
+    void operator()() const
+    {
+        state->run();
+    }
+};
+
+template<class R, class F>
+R reduce_tree(std::vector<R>& xs, const F& f)
+{
+    while (xs.size() > 1)
+    {
+        std::size_t n = xs.size() / 2;
+        for(std::size_t i = 0; i < n; i++) xs[i] = f(fit::move(xs[2*i]), fit::move(xs[2*i+1]));
+        if (xs.size() % 2 == 1) xs[n++] = fit::move(xs.back());
+        xs.erase(xs.begin() + n, xs.end());
+    }
+    return fit::move(xs.front());
+}
+
+template<class R, class Executor, class Fold, class F>
+R reduce_impl(Executor& e, std::size_t n, const Fold& fold, const F& f, reduce_order order)
+{
+    std::size_t threads = executor_concurrency(e);
+    std::size_t chunk_size = FIT_REDUCE_CHUNK_SIZE;
+    if (order == reduce_order::any)
+    {
+        // Fewer chunks are cheaper to schedule, but there should still be
+        // enough of them to balance the load between threads
+        std::size_t max_count = 4 * (threads + 1);
+        if (n / chunk_size > max_count) chunk_size = (n + max_count - 1) / max_count;
+    }
+    if (n <= chunk_size) return reduce_chunk<R, Fold>{fold, 0, n}();
+
+    typedef reduce_state<R, Fold> state_type;
+    std::shared_ptr<state_type> state = std::make_shared<state_type>(fold, n, chunk_size);
+    std::size_t tasks = state->count - 1 < threads ? state->count - 1 : threads;
+    for(std::size_t i = 0; i < tasks; i++)
+    {
+        try
+        {
+            e.execute(reduce_task<state_type>{state});
+        }
+        catch(...)
+        {
+            // The calling thread will fold the chunks instead
+            break;
+        }
+    }
+    state->run();
+    state->wait();
+
+    std::vector<R> partials;
+    partials.reserve(state->count);
+    for(std::size_t i = 0; i < state->count; i++) partials.push_back(state->results[i].get());
+    return reduce_tree(partials, f);
+}
+
+template<class Range>
+struct reduce_range
+{
+    typedef decltype(std::begin(std::declval<Range&>())) iterator;
+    typedef typename std::decay<decltype(*std::declval<iterator>())>::type value_type;
+};
+
+template<class Range, class State>
+struct reduce_result
+{
+    typedef typename std::decay<State>::type type;
+};
+
+template<class Range>
+struct reduce_result<Range, void>
+{
+    typedef typename reduce_range<Range>::value_type type;
+};
+
+template<class Range, class Projection, class F>
+struct transform_reduce_result
+{
+    typedef typename std::decay<decltype(std::declval<const Projection&>()(*std::declval<typename reduce_range<Range>::iterator>()))>::type projected;
+    typedef typename std::decay<decltype(std::declval<const F&>()(std::declval<projected>(), std::declval<projected>()))>::type type;
+};
+
+template<class R, class F, class State>
+R reduce_init(const compress_adaptor<F, State>& c, R&& x)
+{
+    return c.base_function(x)(c.get_state(x), fit::move(x));
+}
+
+template<class R, class F>
+R reduce_init(const compress_adaptor<F, void>&, R&& x)
+{
+    return fit::move(x);
+}
+
+template<class R, class F, class State>
+R reduce_empty(const compress_adaptor<F, State>& c)
+{
+    return c.get_state();
+}
+
+template<class R, class F>
+R reduce_empty(const compress_adaptor<F, void>&)
+{
+    return R();
+}
+
+struct reduce_with_f
+{
+    template<class Executor, class Range, class F, class State,
+        class R=typename reduce_result<Range, State>::type>
+    R operator()(Executor& e, Range&& r, const compress_adaptor<F, State>& c, reduce_order order=reduce_order::any) const
+    {
+        using std::begin;
+        using std::end;
+        auto first = begin(r);
+        std::size_t n = end(r) - first;
+        if (n == 0) return reduce_empty<R>(c);
+        typedef reduce_fold<decltype(first), R, F> fold_type;
+        fold_type fold{first, c.base_function(r)};
+        return reduce_init(c, reduce_impl<R>(e, n, fold, c.base_function(r), order));
+    }
+};
+
+struct transform_reduce_with_f
+{
+    template<class Executor, class Range, class Projection, class F,
+        class R=typename transform_reduce_result<Range, Projection, F>::type>
+    R operator()(Executor& e, Range&& r, const by_adaptor<Projection, F>& b, reduce_order order=reduce_order::any) const
+    {
+        using std::begin;
+        using std::end;
+        auto first = begin(r);
+        std::size_t n = end(r) - first;
+        if (n == 0) return R();
+        typedef transform_reduce_fold<decltype(first), R, Projection, F> fold_type;
+        fold_type fold{first, b.base_projection(r), b.base_function(r)};
+        return reduce_impl<R>(e, n, fold, b.base_function(r), order);
+    }
+};
+
+struct reduce_f
+{
+    template<class Range, class F, class State,
+        class R=typename reduce_result<Range, State>::type>
+    R operator()(Range&& r, const compress_adaptor<F, State>& c, reduce_order order=reduce_order::any) const
+    {
+        return reduce_with_f()(default_work_stealing_pool(), r, c, order);
+    }
+};
+
+struct transform_reduce_f
+{
+    template<class Range, class Projection, class F,
+        class R=typename transform_reduce_result<Range, Projection, F>::type>
+    R operator()(Range&& r, const by_adaptor<Projection, F>& b, reduce_order order=reduce_order::any) const
+    {
+        return transform_reduce_with_f()(default_work_stealing_pool(), r, b, order);
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(reduce, detail::reduce_f);
+FIT_DECLARE_STATIC_VAR(transform_reduce, detail::transform_reduce_f);
+FIT_DECLARE_STATIC_VAR(reduce_with, detail::reduce_with_f);
+FIT_DECLARE_STATIC_VAR(transform_reduce_with, detail::transform_reduce_with_f);
+
+}
+
+#endif
@@ -0,0 +1,253 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    sort_by.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_SORT_BY_H
+#define FIT_GUARD_SORT_BY_H
+
+/// sort_by
+/// =======
+///
+/// Description
+/// -----------
+///
+/// The `sort_by` function sorts a range by the keys that a projection
+/// computes from its elements, and `stable_sort_by` does the same while
+/// keeping equal elements in their original order. Sorting with
+/// `fit::by(projection, cmp)` as the comparator calls the projection twice
+/// for each comparison, which is slow when computing the key is expensive.
+/// These functions call the projection only once for each element instead.
+/// They store each key along with the index of its element, sort the keys,
+/// and then move the elements into their sorted place.
+///
+/// When the keys are integers and are compared with `<`, they are sorted
+/// with a radix sort rather than by comparing them. The comparison can also
+/// be given with `by`, as in `sort_by(range, by(projection, cmp))`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Range, class Projection>
+///     void sort_by(Range&& r, Projection p);
+///
+///     template<class Range, class Projection, class Compare>
+///     void sort_by(Range&& r, Projection p, Compare cmp);
+///
+///     template<class Range, class Projection, class Compare>
+///     void sort_by(Range&& r, by_adaptor<Projection, Compare> f);
+///
+///     template<class Range, class Projection>
+///     void stable_sort_by(Range&& r, Projection p);
+///
+///     template<class Range, class Projection, class Compare>
+///     void stable_sort_by(Range&& r, Projection p, Compare cmp);
+///
+///     template<class Range, class Projection, class Compare>
+///     void stable_sort_by(Range&& r, by_adaptor<Projection, Compare> f);
+///
+/// Requirements
+/// ------------
+///
+/// Range must have random access iterators, and its elements must be:
+///
+///     MoveConstructible
+///     MoveAssignable
+///
+/// Projection must be:
+///
+///     UnaryFunctionObject
+///
+/// Compare must be:
+///
+///     BinaryFunctionObject
+///
+/// Example
+/// -------
+///
+///     std::vector<std::string> names = {"bob", "Alice", "carol"};
+///     fit::sort_by(names, to_lower());
+///     assert(names[0] == "Alice");
+///
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fit/by.h>
+#include <fit/detail/forward.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+#ifndef FIT_SORT_BY_RADIX_THRESHOLD
+#define FIT_SORT_BY_RADIX_THRESHOLD 256
+#endif
+
+namespace fit {
+
+namespace detail {
+
+struct sort_less
+{
+    template<class T, class U>
+    constexpr bool operator()(const T& x, const U& y) const
+    {
+        return x < y;
+    }
+};
+
+template<class Key, class Compare>
+struct is_radix_sortable
+: std::integral_constant<bool, (
+    std::is_integral<Key>::value &&
+    !std::is_same<Key, bool>::value && (
+        std::is_same<Compare, sort_less>::value ||
+        std::is_same<Compare, std::less<Key>>::value ||
+        std::is_same<Compare, std::less<void>>::value
+    )
+)>
+{};
+
+template<class Key>
+struct sort_key
+{
+    Key key;
+    std::size_t index;
+};
+
+template<class Key>
+typename std::make_unsigned<Key>::type radix_bits(Key x)
+{
+    typedef typename std::make_unsigned<Key>::type unsigned_key;
+    // Flipping the sign bit puts negative numbers before positive ones
+    return std::is_signed<Key>::value ?
+        unsigned_key(unsigned_key(x) ^ (unsigned_key(1) << (std::numeric_limits<unsigned_key>::digits - 1))) :
+        unsigned_key(x);
+}
+
+// A least significant digit radix sort, a byte at a time. It is stable, so
+// it is used for both sort_by and stable_sort_by. Bytes that are the same
+// for every key are skipped.
+template<class Key>
+void radix_sort(std::vector<sort_key<Key>>& keys)
+{
+    std::vector<sort_key<Key>> buffer(keys.size());
+    for(std::size_t shift = 0; shift < sizeof(Key) * 8; shift += 8)
+    {
+        std::size_t counts[256] = {};
+        for(const sort_key<Key>& k:keys) counts[(radix_bits(k.key) >> shift) & 0xff]++;
+        if (std::count(counts, counts + 256, keys.size()) == 1) continue;
+        std::size_t offset = 0;
+        for(std::size_t& c:counts)
+        {
+            std::size_t n = c;
+            c = offset;
+            offset += n;
+        }
+        for(sort_key<Key>& k:keys) buffer[counts[(radix_bits(k.key) >> shift) & 0xff]++] = fit::move(k);
+        keys.swap(buffer);
+    }
+}
+
+template<class Key, class Compare>
+struct sort_key_compare
+{
+    const Compare& cmp;
+
+    bool operator()(const sort_key<Key>& x, const sort_key<Key>& y) const
+    {
+        return cmp(x.key, y.key);
+    }
+};
+
+template<class Key, class Compare>
+void sort_keys(std::vector<sort_key<Key>>& keys, const Compare&, bool, std::true_type)
+{
+    if (keys.size() >= FIT_SORT_BY_RADIX_THRESHOLD) radix_sort(keys);
+    else std::stable_sort(keys.begin(), keys.end(), sort_key_compare<Key, sort_less>{sort_less()});
+}
+
+template<class Key, class Compare>
+void sort_keys(std::vector<sort_key<Key>>& keys, const Compare& cmp, bool stable, std::false_type)
+{
+    if (stable) std::stable_sort(keys.begin(), keys.end(), sort_key_compare<Key, Compare>{cmp});
+    else std::sort(keys.begin(), keys.end(), sort_key_compare<Key, Compare>{cmp});
+}
+
+// Moves each element to its sorted place by following the cycles of the
+// permutation, so every element is moved once, plus once per cycle
+template<class Iterator, class Key>
+void sort_by_permute(Iterator first, std::vector<sort_key<Key>>& keys)
+{
+    typedef typename std::iterator_traits<Iterator>::value_type value_type;
+    for(std::size_t i = 0; i < keys.size(); i++)
+    {
+        if (keys[i].index == i) continue;
+        value_type x = fit::move(first[i]);
+        std::size_t j = i;
+        while (keys[j].index != i)
+        {
+            std::size_t next = keys[j].index;
+            first[j] = fit::move(first[next]);
+            keys[j].index = j;
+            j = next;
+        }
+        first[j] = fit::move(x);
+        keys[j].index = j;
+    }
+}
+
+template<class R, class Projection, class Compare>
+void sort_by_impl(R&& r, const Projection& p, const Compare& cmp, bool stable)
+{
+    using std::begin;
+    using std::end;
+    auto first = begin(r);
+    auto last = end(r);
+    typedef typename std::decay<decltype(p(*first))>::type key_type;
+    std::vector<sort_key<key_type>> keys;
+    keys.reserve(last - first);
+    std::size_t i = 0;
+    for(auto it = first; it != last; ++it, ++i) keys.push_back(sort_key<key_type>{p(*it), i});
+    sort_keys(keys, cmp, stable, is_radix_sortable<key_type, Compare>());
+    sort_by_permute(first, keys);
+}
+
+template<bool Stable>
+struct sort_by_f
+{
+    template<class R, class Projection>
+    void operator()(R&& r, const Projection& p) const
+    {
+        sort_by_impl(r, p, sort_less(), Stable);
+    }
+
+    template<class R, class Projection, class Compare>
+    void operator()(R&& r, const Projection& p, const Compare& cmp) const
+    {
+        sort_by_impl(r, p, cmp, Stable);
+    }
+
+    template<class R, class Projection, class Compare, typename std::enable_if<(
+        !std::is_void<Compare>::value
+    ), int>::type = 0>
+    void operator()(R&& r, const by_adaptor<Projection, Compare>& f) const
+    {
+        sort_by_impl(r, f.base_projection(r), f.base_function(r), Stable);
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(sort_by, detail::sort_by_f<false>);
+FIT_DECLARE_STATIC_VAR(stable_sort_by, detail::sort_by_f<true>);
+
+}
+
+#endif
@@ -16,11 +16,18 @@
 /// 
 /// The `static_` adaptor is a static function adaptor that allows any
 /// default-constructible function object to be static-initialized. Functions
-/// initialized by `static_` cannot be used in `constexpr` functions. If the
-/// function needs to be statically initialized and called in a `constexpr`
-/// context, then a `constexpr` constructor needs to be used rather than
-/// `static_`.
-/// 
+/// initialized by `static_` cannot be used in `constexpr` functions, unless
+/// the function object is an empty literal type, in which case it is
+/// constructed on every call instead of being stored in a static variable.
+/// If a non-empty function needs to be statically initialized and called in
+/// a `constexpr` context, then a `constexpr` constructor needs to be used
+/// rather than `static_`.
+///
+/// The `static_` object itself holds no state, so it never needs a dynamic
+/// initializer at program startup, and can be declared with `FIT_CONSTINIT`
+/// to check this. The function object is constructed the first time it is
+/// called instead.
+///
 /// Synopsis
 /// --------
 /// 
@@ -58,10 +65,24 @@
 /// 
 
 #include <fit/detail/result_of.h>
+#include <fit/detail/delegate.h>
 #include <fit/reveal.h>
 
 namespace fit { 
 
+namespace detail {
+
+template<class F>
+struct is_static_constexpr
+: std::integral_constant<bool, 
+    std::is_empty<F>::value && 
+    is_default_constructible<F>::value &&
+    is_constexpr_default_constructible<F>::value
+>
+{};
+
+}
+
 template<class F>
 struct static_
 {
@@ -78,10 +99,15 @@ struct static_
 
     FIT_RETURNS_CLASS(static_);
 
-    template<class... Ts>
+    template<class... Ts, class G=F, typename std::enable_if<(!detail::is_static_constexpr<G>::value), int>::type = 0>
     FIT_SFINAE_RESULT(F, id_<Ts>...) 
     operator()(Ts && ... xs) const
     FIT_SFINAE_RETURNS(FIT_CONST_THIS->base_function()(fit::forward<Ts>(xs)...));
+
+    template<class... Ts, class G=F, typename std::enable_if<(detail::is_static_constexpr<G>::value), int>::type = 0>
+    constexpr FIT_SFINAE_RESULT(G, id_<Ts>...) 
+    operator()(Ts && ... xs) const
+    FIT_SFINAE_RETURNS(G()(fit::forward<Ts>(xs)...));
 };
 
 
@@ -0,0 +1,337 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    thread_pool.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_THREAD_POOL_H
+#define FIT_GUARD_THREAD_POOL_H
+
+/// thread_pool
+/// ===========
+///
+/// Description
+/// -----------
+///
+/// The `thread_pool` class is a simple executor, which runs tasks on a fixed
+/// number of worker threads. Tasks are submitted with `execute`, and are run
+/// in the order they were submitted. The destructor waits for every task
+/// that has been submitted to finish before joining the threads.
+///
+/// The `work_stealing_pool` class is an executor that gives each worker
+/// thread its own queue. Tasks submitted from one of its worker threads are
+/// pushed onto that worker's queue, and are run in last-in first-out order,
+/// which keeps the data they use in that worker's cache. Tasks submitted from
+/// other threads are spread over the queues. When a worker's queue is empty,
+/// it steals the oldest task from another worker's queue.
+///
+/// An executor is any object with an `execute` member function that takes a
+/// nullary, move-constructible function object, and runs it at some later
+/// point, possibly on another thread. The parallel adaptors in this library
+/// can be used with any executor. If the executor also has a `size` member
+/// function, it is used as the number of threads the executor runs tasks on,
+/// otherwise `std::thread::hardware_concurrency()` is assumed. By default, they use the pools returned by
+/// `default_thread_pool` and `default_work_stealing_pool`, which have one
+/// thread for each hardware thread.
+///
+/// Synopsis
+/// --------
+///
+///     class thread_pool
+///     {
+///         explicit thread_pool(std::size_t threads=std::thread::hardware_concurrency());
+///         ~thread_pool();
+///
+///         template<class F>
+///         void execute(F f);
+///
+///         std::size_t size() const;
+///     };
+///
+///     class work_stealing_pool
+///     {
+///         explicit work_stealing_pool(std::size_t threads=std::thread::hardware_concurrency());
+///         ~work_stealing_pool();
+///
+///         template<class F>
+///         void execute(F f);
+///
+///         std::size_t size() const;
+///     };
+///
+///     thread_pool& default_thread_pool();
+///
+///     work_stealing_pool& default_work_stealing_pool();
+///
+/// Example
+/// -------
+///
+///     std::atomic<int> n(0);
+///     {
+///         fit::thread_pool pool(2);
+///         for(int i=0;i<10;i++) pool.execute([&]{ n++; });
+///     }
+///     assert(n == 10);
+///
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <fit/unique_function.h>
+#include <fit/detail/holder.h>
+#include <fit/detail/move.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class Executor, class=void>
+struct executor_size
+{
+    static std::size_t apply(const Executor&)
+    {
+        std::size_t n = std::thread::hardware_concurrency();
+        return n == 0 ? 1 : n;
+    }
+};
+
+template<class Executor>
+struct executor_size<Executor, typename holder<
+    decltype(std::declval<const Executor&>().size())
+>::type>
+{
+    static std::size_t apply(const Executor& e)
+    {
+        return e.size();
+    }
+};
+
+template<class Executor>
+std::size_t executor_concurrency(const Executor& e)
+{
+    return executor_size<Executor>::apply(e);
+}
+
+}
+
+class thread_pool
+{
+    typedef unique_function<void()> task;
+
+    std::vector<std::thread> threads;
+    std::deque<task> tasks;
+    std::mutex m;
+    std::condition_variable cv;
+    bool stopping;
+
+    void run()
+    {
+        for(;;)
+        {
+            task t;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                cv.wait(lock, [this] { return stopping || !tasks.empty(); });
+                if (tasks.empty()) return;
+                t = fit::move(tasks.front());
+                tasks.pop_front();
+            }
+            t();
+        }
+    }
+public:
+    explicit thread_pool(std::size_t n=std::thread::hardware_concurrency())
+    : stopping(false)
+    {
+        if (n == 0) n = 1;
+        threads.reserve(n);
+        for(std::size_t i = 0; i < n; i++) threads.emplace_back([this] { this->run(); });
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    ~thread_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for(std::thread& t:threads) t.join();
+    }
+
+    template<class F>
+    void execute(F f)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            tasks.emplace_back(fit::move(f));
+        }
+        cv.notify_one();
+    }
+
+    std::size_t size() const
+    {
+        return threads.size();
+    }
+};
+
+inline thread_pool& default_thread_pool()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+class work_stealing_pool
+{
+    typedef unique_function<void()> task;
+
+    struct worker_queue
+    {
+        std::mutex m;
+        std::deque<task> tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> queues;
+    std::vector<std::thread> threads;
+    std::mutex m;
+    std::condition_variable cv;
+    std::atomic<std::size_t> pending;
+    std::atomic<std::size_t> sleeping;
+    bool stopping;
+    std::atomic<std::size_t> next;
+
+    struct worker_id
+    {
+        const work_stealing_pool* pool;
+        std::size_t index;
+    };
+
+    static worker_id& current_worker()
+    {
+        static thread_local worker_id id = { nullptr, 0 };
+        return id;
+    }
+
+    bool try_pop(std::size_t i, task& t)
+    {
+        worker_queue& q = *queues[i];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.tasks.empty()) return false;
+        t = fit::move(q.tasks.back());
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool try_steal(std::size_t i, task& t)
+    {
+        for(std::size_t k = 1; k < queues.size(); k++)
+        {
+            worker_queue& q = *queues[(i + k) % queues.size()];
+            std::lock_guard<std::mutex> lock(q.m);
+            if (q.tasks.empty()) continue;
+            t = fit::move(q.tasks.front());
+            q.tasks.pop_front();
+            return true;
+        }
+        return false;
+    }
+
+    void run(std::size_t i)
+    {
+        current_worker().pool = this;
+        current_worker().index = i;
+        for(;;)
+        {
+            task t;
+            if (this->try_pop(i, t) || this->try_steal(i, t))
+            {
+                pending--;
+                t();
+                continue;
+            }
+            // The pool lock is only taken to sleep. The worker counts itself
+            // as sleeping before it checks pending, and execute increments
+            // pending before it checks for sleeping workers, so one of them
+            // always sees the other.
+            std::unique_lock<std::mutex> lock(m);
+            sleeping++;
+            cv.wait(lock, [this] { return stopping || pending.load() > 0; });
+            sleeping--;
+            if (stopping && pending.load() == 0) return;
+        }
+    }
+public:
+    explicit work_stealing_pool(std::size_t n=std::thread::hardware_concurrency())
+    : pending(0), sleeping(0), stopping(false), next(0)
+    {
+        if (n == 0) n = 1;
+        queues.reserve(n);
+        for(std::size_t i = 0; i < n; i++) queues.emplace_back(new worker_queue());
+        threads.reserve(n);
+        for(std::size_t i = 0; i < n; i++) threads.emplace_back([this, i] { this->run(i); });
+    }
+
+    work_stealing_pool(const work_stealing_pool&) = delete;
+    work_stealing_pool& operator=(const work_stealing_pool&) = delete;
+
+    ~work_stealing_pool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        cv.notify_all();
+        for(std::thread& t:threads) t.join();
+    }
+
+    template<class F>
+    void execute(F f)
+    {
+        const worker_id& id = current_worker();
+        std::size_t i = (id.pool == this) ? id.index : (next++ % queues.size());
+        // Count the task before publishing it, so a worker can't take it and
+        // decrement pending before it has been incremented
+        pending++;
+        try
+        {
+            std::lock_guard<std::mutex> lock(queues[i]->m);
+            queues[i]->tasks.emplace_back(fit::move(f));
+        }
+        catch(...)
+        {
+            pending--;
+            throw;
+        }
+        if (sleeping.load() > 0)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m);
+            }
+            cv.notify_one();
+        }
+    }
+
+    std::size_t size() const
+    {
+        return threads.size();
+    }
+};
+
+inline work_stealing_pool& default_work_stealing_pool()
+{
+    static work_stealing_pool pool;
+    return pool;
+}
+
+}
+
+#endif
@@ -0,0 +1,371 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    trace.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_TRACE_H
+#define FIT_GUARD_TRACE_H
+
+/// trace
+/// =====
+///
+/// Description
+/// -----------
+///
+/// The `trace` function adaptor records a begin event when the function is
+/// called and an end event when it returns or throws, with the given name,
+/// the thread and a timestamp. Wrapping the stages of a `flow`, the
+/// functions given to `partial`, or the function given to `fix` shows when
+/// each one ran, and how deeply they were nested.
+///
+/// Each thread writes its events into its own ring buffer of
+/// `FIT_TRACE_BUFFER_SIZE` events, which must be a power of two. Writing an
+/// event never takes a lock or waits for other threads. When the buffer is
+/// full, the oldest events are overwritten. The `trace_dump_json` function
+/// writes the events of every thread in the Chrome trace event format, which
+/// can be loaded into `chrome://tracing` or Perfetto. It can be called while
+/// other threads are still tracing. Events that are overwritten while they
+/// are being read are left out. The `trace_clear` function discards every
+/// event recorded so far.
+///
+/// To keep the cost low enough for production builds, `trace` can be given a
+/// sampling rate `n`, so that only every `n`th traced call on each thread is
+/// recorded. The other calls only increment a counter. The calls are counted
+/// separately for each name, so adaptors with different rates don't affect
+/// each other, while adaptors with the same name share a counter.
+///
+/// On x86, the timestamps are read from the time-stamp counter, which is
+/// converted to microseconds when the events are written out. This assumes
+/// the processor has an invariant time-stamp counter, as all recent x86
+/// processors do. Defining `FIT_TRACE_USE_TSC` to `0` uses
+/// `std::chrono::steady_clock` instead.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     trace_adaptor<F> trace(const char* name, F f, std::uint32_t n=1);
+///
+///     void trace_dump_json(std::ostream& os);
+///
+///     void trace_clear();
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// The name must be a string with static storage duration, such as a string
+/// literal, since only the pointer is recorded.
+///
+/// Example
+/// -------
+///
+///     auto f = fit::flow(
+///         fit::trace("parse", parse_f()),
+///         fit::trace("serialize", serialize_f(), 100)
+///     );
+///     for(auto&& line:lines) f(line);
+///     std::ofstream file("trace.json");
+///     fit::trace_dump_json(file);
+///
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <fit/always.h>
+#include <fit/detail/forward.h>
+#include <fit/detail/json.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+#ifndef FIT_TRACE_USE_TSC
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FIT_TRACE_USE_TSC 1
+#else
+#define FIT_TRACE_USE_TSC 0
+#endif
+#endif
+
+#if FIT_TRACE_USE_TSC
+#include <x86intrin.h>
+#endif
+
+#ifndef FIT_TRACE_BUFFER_SIZE
+#define FIT_TRACE_BUFFER_SIZE 4096
+#endif
+
+namespace fit {
+
+namespace detail {
+
+static_assert((FIT_TRACE_BUFFER_SIZE & (FIT_TRACE_BUFFER_SIZE - 1)) == 0,
+    "FIT_TRACE_BUFFER_SIZE must be a power of two");
+
+inline std::uint64_t trace_steady_ns()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()
+    ).count();
+}
+
+inline std::uint64_t trace_now()
+{
+#if FIT_TRACE_USE_TSC
+    return __rdtsc();
+#else
+    return trace_steady_ns();
+#endif
+}
+
+struct trace_event
+{
+    std::atomic<std::uint64_t> ts;
+    std::atomic<const char*> name;
+    std::atomic<char> phase;
+};
+
+// A single-writer ring buffer. The owning thread is the only writer. It
+// claims the index of an event before writing it, and publishes it with the
+// head afterwards, so a reader can tell which of the events it read could
+// have been overwritten in the meantime, like with a sequence lock.
+struct trace_buffer
+{
+    static constexpr std::uint64_t capacity = FIT_TRACE_BUFFER_SIZE;
+
+    trace_event events[FIT_TRACE_BUFFER_SIZE];
+    std::atomic<std::uint64_t> head;
+    std::atomic<std::uint64_t> claimed;
+    std::atomic<std::uint64_t> start;
+    // The calls counted towards the next sample, for each name
+    std::unordered_map<const char*, std::uint32_t> samples;
+    std::size_t tid;
+
+    explicit trace_buffer(std::size_t tid) : head(0), claimed(0), start(0), tid(tid)
+    {}
+
+    bool sample(const char* name, std::uint32_t n)
+    {
+        if (n <= 1) return true;
+        std::uint32_t& count = samples[name];
+        if (++count < n) return false;
+        count = 0;
+        return true;
+    }
+
+    void record(const char* name, char phase)
+    {
+        std::uint64_t h = head.load(std::memory_order_relaxed);
+        claimed.store(h + 1, std::memory_order_relaxed);
+        trace_event& e = events[h & (capacity - 1)];
+        e.ts.store(trace_now(), std::memory_order_release);
+        e.name.store(name, std::memory_order_release);
+        e.phase.store(phase, std::memory_order_release);
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    struct snapshot_event
+    {
+        std::uint64_t ts;
+        const char* name;
+        char phase;
+    };
+
+    std::vector<snapshot_event> snapshot() const
+    {
+        std::uint64_t h = head.load(std::memory_order_acquire);
+        std::uint64_t lo = start.load(std::memory_order_relaxed);
+        if (h > capacity && h - capacity > lo) lo = h - capacity;
+        std::vector<snapshot_event> result;
+        result.reserve(h - lo);
+        for(std::uint64_t i = lo; i < h; i++)
+        {
+            const trace_event& e = events[i & (capacity - 1)];
+            result.push_back(snapshot_event{
+                e.ts.load(std::memory_order_acquire),
+                e.name.load(std::memory_order_acquire),
+                e.phase.load(std::memory_order_acquire)
+            });
+        }
+        // If any of the events were overwritten while they were being read,
+        // the writer has claimed the index that overwrote them
+        std::uint64_t c = claimed.load(std::memory_order_relaxed);
+        if (c > capacity && c - capacity > lo)
+        {
+            std::uint64_t n = c - capacity - lo;
+            result.erase(result.begin(), result.begin() + (n < result.size() ? n : result.size()));
+        }
+        return result;
+    }
+
+    void clear()
+    {
+        start.store(head.load(std::memory_order_acquire), std::memory_order_relaxed);
+    }
+};
+
+class trace_registry
+{
+    std::mutex m;
+    std::vector<std::shared_ptr<trace_buffer>> buffers;
+    std::uint64_t tsc0;
+    std::uint64_t ns0;
+public:
+    trace_registry() : tsc0(trace_now()), ns0(trace_steady_ns())
+    {}
+
+    static trace_registry& instance()
+    {
+        static trace_registry r;
+        return r;
+    }
+
+    std::shared_ptr<trace_buffer> add_thread()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        buffers.push_back(std::make_shared<trace_buffer>(buffers.size() + 1));
+        return buffers.back();
+    }
+
+    std::vector<std::shared_ptr<trace_buffer>> get_buffers()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        return buffers;
+    }
+
+    // Returns the number of timestamp ticks per microsecond, measured since
+    // the registry was created
+    double ticks_per_us() const
+    {
+#if FIT_TRACE_USE_TSC
+        std::uint64_t ns = trace_steady_ns() - ns0;
+        std::uint64_t ticks = trace_now() - tsc0;
+        return ns > 0 ? 1000.0 * double(ticks) / double(ns) : 1000.0;
+#else
+        return 1000.0;
+#endif
+    }
+
+    std::uint64_t origin() const
+    {
+        return tsc0;
+    }
+};
+
+inline trace_buffer& trace_thread_buffer()
+{
+    // The registry owns the buffer too, so its events can still be written
+    // out after the thread exits
+    static thread_local std::shared_ptr<trace_buffer> buffer = trace_registry::instance().add_thread();
+    return *buffer;
+}
+
+struct trace_scope
+{
+    trace_buffer* buffer;
+    const char* name;
+
+    trace_scope(const char* name, std::uint32_t n) : buffer(nullptr), name(name)
+    {
+        trace_buffer& b = trace_thread_buffer();
+        if (b.sample(name, n))
+        {
+            buffer = &b;
+            buffer->record(name, 'B');
+        }
+    }
+
+    ~trace_scope()
+    {
+        if (buffer != nullptr) buffer->record(name, 'E');
+    }
+};
+
+}
+
+template<class F>
+struct trace_adaptor : F
+{
+    const char* name;
+    std::uint32_t n;
+
+    template<class X>
+    constexpr trace_adaptor(const char* name, X&& x, std::uint32_t n=1)
+    : F(fit::forward<X>(x)), name(name), n(n)
+    {}
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts, class R=decltype(std::declval<const F&>()(std::declval<Ts>()...))>
+    R operator()(Ts&&... xs) const
+    {
+        detail::trace_scope scope(name, n);
+        return this->base_function(xs...)(fit::forward<Ts>(xs)...);
+    }
+};
+
+namespace detail {
+
+struct trace_f
+{
+    template<class F>
+    constexpr trace_adaptor<F> operator()(const char* name, F f, std::uint32_t n=1) const
+    {
+        return trace_adaptor<F>(name, fit::move(f), n);
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(trace, detail::trace_f);
+
+inline void trace_dump_json(std::ostream& os)
+{
+    detail::trace_registry& r = detail::trace_registry::instance();
+    double ticks_per_us = r.ticks_per_us();
+    std::uint64_t origin = r.origin();
+    os << "{\"traceEvents\":[";
+    bool first = true;
+    for(auto&& b:r.get_buffers())
+    {
+        for(auto&& e:b->snapshot())
+        {
+            if (!first) os << ',';
+            first = false;
+            os << "{\"name\":";
+            detail::json_write_string(os, e.name, e.name + std::strlen(e.name));
+            os << ",\"ph\":\"" << e.phase << "\""
+                << ",\"ts\":" << (e.ts > origin ? double(e.ts - origin) / ticks_per_us : 0.0)
+                << ",\"pid\":1"
+                << ",\"tid\":" << b->tid
+                << '}';
+        }
+    }
+    os << "],\"displayTimeUnit\":\"ns\"}";
+}
+
+inline void trace_clear()
+{
+    for(auto&& b:detail::trace_registry::instance().get_buffers()) b->clear();
+}
+
+}
+
+#endif
@@ -0,0 +1,192 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    trampoline_fix.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_TRAMPOLINE_FIX_H
+#define FIT_GUARD_FUNCTION_TRAMPOLINE_FIX_H
+
+/// trampoline_fix
+/// ==============
+///
+/// Description
+/// -----------
+///
+/// The `trampoline_fix` function adaptor implements a fixed-point combinator
+/// for tail-recursive functions that runs in constant stack space. Like
+/// `fix`, the first parameter passed to the function is the function itself,
+/// however, calling it doesn't recurse. Instead, it returns a continuation
+/// that holds the arguments for the next call, which the function must
+/// return. The adaptor then calls the function again with these arguments in
+/// a loop until a final value is returned.
+///
+/// The function must return a `trampoline_result<R, Ts...>`, where `R` is the
+/// final result and `Ts...` are the types of the arguments for the next
+/// call. It can be implicitly constructed from either a value of `R` or the
+/// continuation returned by the self parameter. Only tail calls are
+/// supported, since the result of the self parameter can't be used inside of
+/// the function.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     constexpr trampoline_fix_adaptor<F> trampoline_fix(F f);
+///
+///     template<class R, class... Ts>
+///     class trampoline_result;
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// R and Ts must be DefaultConstructible and MoveConstructible.
+///
+/// Example
+/// -------
+///
+///     struct sum_f
+///     {
+///         template<class Self>
+///         fit::trampoline_result<long long, long long, long long>
+///         operator()(Self self, long long acc, long long n) const
+///         {
+///             if (n == 0) return acc;
+///             return self(acc + n, n - 1);
+///         }
+///     };
+///
+///     long long r = fit::trampoline_fix(sum_f())(0LL, 1000000LL);
+///     assert(r == 500000500000LL);
+///
+
+#include <tuple>
+#include <type_traits>
+#include <fit/always.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/make.h>
+#include <fit/detail/seq.h>
+#include <fit/detail/static_const_var.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class... Ts>
+struct trampoline_call
+{
+    std::tuple<Ts...> args;
+};
+
+struct trampoline_self
+{
+    template<class... Xs>
+    constexpr trampoline_call<typename std::decay<Xs>::type...> operator()(Xs&&... xs) const
+    {
+        return trampoline_call<typename std::decay<Xs>::type...>{
+            std::tuple<typename std::decay<Xs>::type...>(fit::forward<Xs>(xs)...)
+        };
+    }
+};
+
+}
+
+template<class R, class... Ts>
+class trampoline_result
+{
+    bool finished;
+    R result;
+    std::tuple<Ts...> args;
+public:
+    typedef R value_type;
+
+    trampoline_result(R x) : finished(true), result(fit::move(x)), args()
+    {}
+
+    template<class... Xs, FIT_ENABLE_IF_CONSTRUCTIBLE(std::tuple<Ts...>, std::tuple<Xs...>&&)>
+    trampoline_result(detail::trampoline_call<Xs...> c) : finished(false), result(), args(fit::move(c.args))
+    {}
+
+    bool done() const
+    {
+        return finished;
+    }
+
+    R& value()
+    {
+        return result;
+    }
+
+    std::tuple<Ts...>& arguments()
+    {
+        return args;
+    }
+};
+
+namespace detail {
+
+template<class F, class... Ts>
+struct trampoline_fix_result
+{
+    typedef decltype(std::declval<const F&>()(trampoline_self(), std::declval<Ts>()...)) type;
+};
+
+template<class Result>
+struct trampoline_fix_check;
+
+template<class R, class... Ts>
+struct trampoline_fix_check<trampoline_result<R, Ts...>>
+{
+    typedef R type;
+};
+
+template<class... Ts>
+constexpr typename gens<sizeof...(Ts)>::type make_trampoline_gens(const std::tuple<Ts...>&)
+{
+    return {};
+}
+
+template<class R, class F, class... Ts, int... Ns>
+void trampoline_fix_bounce(R& r, const F& f, std::tuple<Ts...>& args, seq<Ns...>)
+{
+    r = f(trampoline_self(), fit::move(std::get<Ns>(args))...);
+}
+
+}
+
+template<class F>
+struct trampoline_fix_adaptor : F
+{
+    typedef trampoline_fix_adaptor fit_rewritable1_tag;
+    FIT_INHERIT_CONSTRUCTOR(trampoline_fix_adaptor, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts,
+        class Result=typename detail::trampoline_fix_result<F, Ts&&...>::type,
+        class R=typename detail::trampoline_fix_check<Result>::type>
+    R operator()(Ts&&... xs) const
+    {
+        const F& f = this->base_function(xs...);
+        Result r = f(detail::trampoline_self(), fit::forward<Ts>(xs)...);
+        while (!r.done()) detail::trampoline_fix_bounce(r, f, r.arguments(), detail::make_trampoline_gens(r.arguments()));
+        return fit::move(r.value());
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(trampoline_fix, detail::make<trampoline_fix_adaptor>);
+
+}
+
+#endif
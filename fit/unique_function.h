@@ -0,0 +1,318 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    unique_function.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_UNIQUE_FUNCTION_H
+#define FIT_GUARD_UNIQUE_FUNCTION_H
+
+/// unique_function
+/// ===============
+///
+/// Description
+/// -----------
+///
+/// The `unique_function` class is an owning, type-erased function object
+/// that only requires the function to be move constructible. So, unlike
+/// `std::function`, it can hold closures with move-only captures. The
+/// `unique_function` itself is move-only.
+///
+/// Functions that fit into `InlineBytes`, and are nothrow move
+/// constructible, are stored inline without any allocation. Larger
+/// functions are allocated using the `Allocator`. The `is_inline_storable`
+/// trait can be used to check at compile-time whether a function will be
+/// stored inline.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Signature,
+///         std::size_t InlineBytes=3*sizeof(void*),
+///         class Allocator=std::allocator<char>>
+///     class unique_function;
+///
+///     template<class R, class... Ts, std::size_t InlineBytes, class Allocator>
+///     class unique_function<R(Ts...), InlineBytes, Allocator>
+///     {
+///         unique_function();
+///         template<class F>
+///         unique_function(F f, const Allocator& a=Allocator());
+///         unique_function(unique_function&&) noexcept;
+///
+///         R operator()(Ts... xs) const;
+///         explicit operator bool() const;
+///     };
+///
+///     template<class F, std::size_t InlineBytes=3*sizeof(void*)>
+///     struct is_inline_storable;
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     auto add = [](const std::unique_ptr<int>& i, int x) { return *i + x; };
+///     auto f = fit::capture(std::unique_ptr<int>(new int(1)))(add);
+///     static_assert(fit::is_inline_storable<decltype(f)>::value, "Allocates");
+///
+///     fit::unique_function<int(int)> g = std::move(f);
+///     assert(g(2) == 3);
+///
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <fit/function_ref.h>
+#include <fit/detail/move.h>
+
+namespace fit {
+
+namespace detail {
+
+template<std::size_t N>
+struct unique_function_buffer_size
+: std::integral_constant<std::size_t, (N < sizeof(void*) ? sizeof(void*) : N)>
+{};
+
+template<std::size_t N>
+struct unique_function_buffer
+{
+    typedef typename std::aligned_storage<unique_function_buffer_size<N>::value>::type type;
+};
+
+}
+
+template<class F, std::size_t InlineBytes=3*sizeof(void*)>
+struct is_inline_storable
+: std::integral_constant<bool,
+    sizeof(F) <= sizeof(typename detail::unique_function_buffer<InlineBytes>::type) &&
+    std::alignment_of<typename detail::unique_function_buffer<InlineBytes>::type>::value % std::alignment_of<F>::value == 0 &&
+    std::is_nothrow_move_constructible<F>::value
+>
+{};
+
+namespace detail {
+
+template<class Allocator, class R, class... Ts>
+struct unique_function_vtable
+{
+    R (*invoke)(const void*, Ts...);
+    void (*move)(void*, void*);
+    void (*destroy)(void*, Allocator&);
+};
+
+template<class F, bool Inline>
+struct unique_function_manager;
+
+template<class F>
+struct unique_function_manager<F, true>
+{
+    static const F& get(const void* p)
+    {
+        return *static_cast<const F*>(p);
+    }
+
+    template<class Allocator, class X>
+    static void create(void* p, Allocator&, X&& x)
+    {
+        new (p) F(fit::forward<X>(x));
+    }
+
+    static void move(void* dst, void* src)
+    {
+        F& f = *static_cast<F*>(src);
+        new (dst) F(fit::move(f));
+        f.~F();
+    }
+
+    template<class Allocator>
+    static void destroy(void* p, Allocator&)
+    {
+        static_cast<F*>(p)->~F();
+    }
+};
+
+template<class F>
+struct unique_function_manager<F, false>
+{
+    static const F& get(const void* p)
+    {
+        return **static_cast<F* const*>(p);
+    }
+
+    template<class Allocator, class X>
+    static void create(void* p, Allocator& a, X&& x)
+    {
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<F> alloc;
+        typedef std::allocator_traits<alloc> traits;
+        alloc af(a);
+        F* f = traits::allocate(af, 1);
+        try
+        {
+            traits::construct(af, f, fit::forward<X>(x));
+        }
+        catch(...)
+        {
+            traits::deallocate(af, f, 1);
+            throw;
+        }
+        *static_cast<F**>(p) = f;
+    }
+
+    static void move(void* dst, void* src)
+    {
+        *static_cast<F**>(dst) = *static_cast<F**>(src);
+    }
+
+    template<class Allocator>
+    static void destroy(void* p, Allocator& a)
+    {
+        typedef typename std::allocator_traits<Allocator>::template rebind_alloc<F> alloc;
+        typedef std::allocator_traits<alloc> traits;
+        alloc af(a);
+        F* f = *static_cast<F**>(p);
+        traits::destroy(af, f);
+        traits::deallocate(af, f, 1);
+    }
+};
+
+template<class F, std::size_t InlineBytes, class Allocator, class R, class... Ts>
+struct unique_function_vtable_for
+{
+    typedef unique_function_manager<F, is_inline_storable<F, InlineBytes>::value> manager;
+
+    static R invoke(const void* p, Ts... xs)
+    {
+        return function_ref_invoke<R>::call(manager::get(p), fit::forward<Ts>(xs)...);
+    }
+
+    static const unique_function_vtable<Allocator, R, Ts...> value;
+};
+
+template<class F, std::size_t InlineBytes, class Allocator, class R, class... Ts>
+const unique_function_vtable<Allocator, R, Ts...>
+unique_function_vtable_for<F, InlineBytes, Allocator, R, Ts...>::value =
+{
+    &unique_function_vtable_for::invoke,
+    &manager::move,
+    &manager::template destroy<Allocator>
+};
+
+}
+
+template<class Signature, std::size_t InlineBytes=3*sizeof(void*), class Allocator=std::allocator<char>>
+class unique_function;
+
+namespace detail {
+
+template<class T>
+struct is_unique_function
+: std::false_type
+{};
+
+template<class Signature, std::size_t InlineBytes, class Allocator>
+struct is_unique_function<unique_function<Signature, InlineBytes, Allocator>>
+: std::true_type
+{};
+
+}
+
+template<class R, class... Ts, std::size_t InlineBytes, class Allocator>
+class unique_function<R(Ts...), InlineBytes, Allocator> : Allocator
+{
+    typedef detail::unique_function_vtable<Allocator, R, Ts...> vtable_type;
+    typename detail::unique_function_buffer<InlineBytes>::type buffer;
+    const vtable_type* vtable;
+
+    Allocator& allocator()
+    {
+        return *this;
+    }
+
+    void reset()
+    {
+        if (vtable != nullptr) vtable->destroy(&buffer, this->allocator());
+        vtable = nullptr;
+    }
+public:
+    template<class F>
+    struct stores_inline
+    : is_inline_storable<F, InlineBytes>
+    {};
+
+    unique_function() : vtable(nullptr)
+    {}
+
+    unique_function(std::nullptr_t) : vtable(nullptr)
+    {}
+
+    template<class F, class D=typename std::decay<F>::type, typename std::enable_if<(
+        !detail::is_unique_function<D>::value &&
+        !std::is_same<D, std::nullptr_t>::value &&
+        is_callable<const D&, Ts...>::value
+    ), int>::type = 0>
+    unique_function(F&& f, const Allocator& a=Allocator())
+    : Allocator(a), vtable(&detail::unique_function_vtable_for<D, InlineBytes, Allocator, R, Ts...>::value)
+    {
+        detail::unique_function_vtable_for<D, InlineBytes, Allocator, R, Ts...>::manager::create(&buffer, this->allocator(), fit::forward<F>(f));
+    }
+
+    unique_function(unique_function&& rhs) noexcept
+    : Allocator(fit::move(rhs.allocator())), vtable(rhs.vtable)
+    {
+        if (vtable != nullptr) vtable->move(&buffer, &rhs.buffer);
+        rhs.vtable = nullptr;
+    }
+
+    unique_function& operator=(unique_function&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            this->reset();
+            this->allocator() = fit::move(rhs.allocator());
+            vtable = rhs.vtable;
+            if (vtable != nullptr) vtable->move(&buffer, &rhs.buffer);
+            rhs.vtable = nullptr;
+        }
+        return *this;
+    }
+
+    unique_function& operator=(std::nullptr_t)
+    {
+        this->reset();
+        return *this;
+    }
+
+    unique_function(const unique_function&) = delete;
+    unique_function& operator=(const unique_function&) = delete;
+
+    ~unique_function()
+    {
+        this->reset();
+    }
+
+    explicit operator bool() const
+    {
+        return vtable != nullptr;
+    }
+
+    R operator()(Ts... xs) const
+    {
+        if (vtable == nullptr) throw std::bad_function_call();
+        return vtable->invoke(&buffer, fit::forward<Ts>(xs)...);
+    }
+};
+
+}
+
+#endif
@@ -71,7 +71,11 @@
 /// ===============
 /// 
 /// How to unpack a sequence can be defined by specializing `unpack_sequence`.
-/// By default, `std::tuple` can be used with unpack.
+/// By default, `std::tuple`, `std::pair`, `std::array`, built-in arrays, and
+/// any other type that specializes `std::tuple_size` and provides `get<N>`
+/// (either `std::get` or found by ADL) can be used with unpack. The elements
+/// are passed directly to the function, with the same value category as the
+/// sequence, so no intermediate tuple is made and the elements are not copied.
 /// 
 /// Synopsis
 /// --------
@@ -94,7 +98,9 @@
 /// 
 
 #include <fit/returns.h>
+#include <cstddef>
 #include <tuple>
+#include <utility>
 #include <fit/detail/seq.h>
 #include <fit/capture.h>
 #include <fit/always.h>
@@ -108,12 +114,58 @@
 
 namespace fit {
 
+namespace detail {
+
+namespace unpack_adl {
+
+using std::get;
+
+template<int N, class Sequence>
+constexpr auto unpack_get(Sequence&& s) FIT_RETURNS
+(
+    get<N>(fit::forward<Sequence>(s))
+);
+
+}
+
+template<class F, class Sequence, int... N>
+constexpr auto unpack_tuple_like(F&& f, Sequence&& s, seq<N...>) FIT_RETURNS
+(
+    f(unpack_adl::unpack_get<N>(fit::forward<Sequence>(s))...)
+);
+
 template<class Sequence, class=void>
-struct unpack_sequence
+struct unpack_tuple_like_sequence
 {
     typedef void not_unpackable;
 };
 
+template<class Sequence>
+struct unpack_tuple_like_sequence<Sequence, typename holder<
+    decltype(std::tuple_size<Sequence>::value)
+>::type>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        detail::unpack_tuple_like(fit::forward<F>(f), fit::forward<S>(s), 
+            typename gens<std::tuple_size<Sequence>::value>::type())
+    );
+};
+
+template<class F, class Sequence, int... N>
+constexpr auto unpack_array(F&& f, Sequence&& s, seq<N...>) FIT_RETURNS
+(
+    f(fit::forward<Sequence>(s)[N]...)
+);
+
+}
+
+template<class Sequence, class=void>
+struct unpack_sequence
+: detail::unpack_tuple_like_sequence<Sequence>
+{};
+
 
 namespace detail {
 template<class Sequence, class=void>
@@ -286,6 +338,16 @@ struct unpack_sequence<std::tuple<Ts...>>
     );
 };
 
+template<class T, std::size_t N>
+struct unpack_sequence<T[N]>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        detail::unpack_array(fit::forward<F>(f), fit::forward<S>(s), typename detail::gens<N>::type())
+    );
+};
+
 template<class T, class... Ts>
 struct unpack_sequence<detail::pack_base<T, Ts...>>
 {
@@ -296,6 +358,16 @@ struct unpack_sequence<detail::pack_base<T, Ts...>>
     );
 };
 
+template<class Seq, class Positions, class... Ts>
+struct unpack_sequence<detail::pack_packed_base<Seq, Positions, Ts...>>
+{
+    template<class F, class P>
+    constexpr static auto apply(F&& f, P&& p) FIT_RETURNS
+    (
+        fit::detail::unpack_pack_packed_base(fit::forward<F>(f), fit::forward<P>(p))
+    );
+};
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,289 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    unpack_n.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_UNPACK_N_H
+#define FIT_GUARD_UNPACK_N_H
+
+/// unpack_n
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `unpack_n` function adaptor takes a sequence whose length is only
+/// known at runtime, such as a `std::vector` or a span, and calls the function
+/// with its elements as separate arguments. So for a sequence of size `k`,
+/// `f(s[0], ..., s[k-1])` is called. A table of function pointers, one for
+/// each length up to `MaxN`, is generated at compile-time, so the call is
+/// dispatched with a single indirect jump rather than by comparing the size
+/// against each length.
+///
+/// If the size is larger than `MaxN`, or the function cannot be called with
+/// that many arguments, then the fallback function is called with the
+/// sequence instead. By default, the fallback throws `std::length_error`.
+///
+/// The sequence must provide `size()` and `operator[]`. The result is the
+/// common type of the results of calling the function for each length.
+///
+/// Synopsis
+/// --------
+///
+///     template<std::size_t MaxN, class F>
+///     constexpr unpack_n_adaptor<MaxN, F> unpack_n(F f);
+///
+///     template<std::size_t MaxN, class F, class Fallback>
+///     constexpr unpack_n_adaptor<MaxN, F, Fallback> unpack_n(F f, Fallback fallback);
+///
+/// Requirements
+/// ------------
+///
+/// F and Fallback must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     struct sum
+///     {
+///         template<class... Ts>
+///         int operator()(Ts... xs) const
+///         {
+///             int result = 0;
+///             for(int x:{0, xs...}) result += x;
+///             return result;
+///         }
+///     };
+///
+///     std::vector<int> v = {1, 2, 3};
+///     assert(fit::unpack_n<4>(sum())(v) == 6);
+///
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <fit/detail/compressed_pair.h>
+#include <fit/detail/holder.h>
+#include <fit/detail/move.h>
+#include <fit/detail/seq.h>
+
+namespace fit {
+
+namespace detail {
+
+struct unpack_n_overflow
+{};
+
+struct unpack_n_skip
+{};
+
+template<int N, class T>
+struct unpack_n_repeat
+{
+    typedef T type;
+};
+
+template<class F, class Seq, class T, class=void>
+struct unpack_n_arity_result
+{
+    typedef unpack_n_skip type;
+};
+
+template<class F, int... Ns, class T>
+struct unpack_n_arity_result<F, seq<Ns...>, T, typename holder<
+    decltype(std::declval<const F&>()(std::declval<typename unpack_n_repeat<Ns, T>::type>()...))
+>::type>
+{
+    typedef decltype(std::declval<const F&>()(std::declval<typename unpack_n_repeat<Ns, T>::type>()...)) type;
+};
+
+template<class T, class U>
+struct unpack_n_merge
+: std::common_type<T, U>
+{};
+
+template<class T>
+struct unpack_n_merge<T, unpack_n_skip>
+{
+    typedef T type;
+};
+
+template<class U>
+struct unpack_n_merge<unpack_n_skip, U>
+{
+    typedef U type;
+};
+
+template<>
+struct unpack_n_merge<unpack_n_skip, unpack_n_skip>
+{
+    typedef unpack_n_skip type;
+};
+
+template<class... Ts>
+struct unpack_n_common;
+
+template<>
+struct unpack_n_common<>
+{
+    typedef unpack_n_skip type;
+};
+
+template<class T, class... Ts>
+struct unpack_n_common<T, Ts...>
+: unpack_n_merge<T, typename unpack_n_common<Ts...>::type>
+{};
+
+template<class T>
+struct unpack_n_enable
+{
+    typedef T type;
+};
+
+template<>
+struct unpack_n_enable<unpack_n_skip>
+{};
+
+template<class S>
+struct unpack_n_element
+{
+    typedef decltype(std::declval<S&>()[0]) type;
+};
+
+template<class F, class T, class Seq>
+struct unpack_n_result_impl;
+
+template<class F, class T, int... Ks>
+struct unpack_n_result_impl<F, T, seq<Ks...>>
+: unpack_n_enable<typename unpack_n_common<
+    typename unpack_n_arity_result<F, typename gens<Ks>::type, T>::type...
+>::type>
+{};
+
+template<class F, class S, std::size_t MaxN, class=void>
+struct unpack_n_result
+{};
+
+template<class F, class S, std::size_t MaxN>
+struct unpack_n_result<F, S, MaxN, typename holder<
+    decltype(std::declval<S&>().size()),
+    typename unpack_n_element<S>::type
+>::type>
+: unpack_n_result_impl<F, typename unpack_n_element<S>::type, typename gens<MaxN+1>::type>
+{};
+
+template<class R, class Fallback>
+struct unpack_n_fallback
+{
+    template<class S>
+    static R call(const Fallback& g, S& s)
+    {
+        return g(s);
+    }
+};
+
+template<class R>
+struct unpack_n_fallback<R, unpack_n_overflow>
+{
+    template<class S>
+    static R call(const unpack_n_overflow&, S&)
+    {
+        throw std::length_error("fit::unpack_n: unsupported number of arguments");
+    }
+};
+
+template<class R, class Seq, bool Callable>
+struct unpack_n_thunk;
+
+template<class R, int... Ns>
+struct unpack_n_thunk<R, seq<Ns...>, true>
+{
+    template<class F, class Fallback, class S>
+    static R call(const F& f, const Fallback&, S& s)
+    {
+        return f(s[Ns]...);
+    }
+};
+
+template<class R, int... Ns>
+struct unpack_n_thunk<R, seq<Ns...>, false>
+{
+    template<class F, class Fallback, class S>
+    static R call(const F&, const Fallback& g, S& s)
+    {
+        return unpack_n_fallback<R, Fallback>::call(g, s);
+    }
+};
+
+template<class F, class S, std::size_t MaxN, int K>
+struct unpack_n_callable
+: std::integral_constant<bool, (K <= int(MaxN)) && !std::is_same<
+    typename unpack_n_arity_result<F, typename gens<K>::type, typename unpack_n_element<S>::type>::type,
+    unpack_n_skip
+>::value>
+{};
+
+template<class R, std::size_t MaxN, class F, class Fallback, class S, int... Ks>
+R unpack_n_dispatch(const F& f, const Fallback& g, S& s, seq<Ks...>)
+{
+    typedef R (*function_pointer)(const F&, const Fallback&, S&);
+    static constexpr function_pointer table[] = {
+        &unpack_n_thunk<R, typename gens<Ks>::type, unpack_n_callable<F, S, MaxN, Ks>::value>::template call<F, Fallback, S>...
+    };
+    const std::size_t n = s.size();
+    return table[n > MaxN ? MaxN+1 : n](f, g, s);
+}
+
+}
+
+template<std::size_t MaxN, class F, class Fallback=detail::unpack_n_overflow>
+struct unpack_n_adaptor
+: detail::compressed_pair<F, Fallback>
+{
+    typedef detail::compressed_pair<F, Fallback> base_type;
+    FIT_INHERIT_CONSTRUCTOR(unpack_n_adaptor, base_type)
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr const Fallback& base_fallback(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class S, class R=typename detail::unpack_n_result<F, S, MaxN>::type>
+    R operator()(S&& s) const
+    {
+        return detail::unpack_n_dispatch<R, MaxN>(
+            this->base_function(s),
+            this->base_fallback(s),
+            s,
+            typename detail::gens<MaxN+2>::type()
+        );
+    }
+};
+
+template<std::size_t MaxN, class F>
+constexpr unpack_n_adaptor<MaxN, F> unpack_n(F f)
+{
+    return unpack_n_adaptor<MaxN, F>(fit::move(f), detail::unpack_n_overflow());
+}
+
+template<std::size_t MaxN, class F, class Fallback>
+constexpr unpack_n_adaptor<MaxN, F, Fallback> unpack_n(F f, Fallback fallback)
+{
+    return unpack_n_adaptor<MaxN, F, Fallback>(fit::move(f), fit::move(fallback));
+}
+
+}
+
+#endif
@@ -0,0 +1,340 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    vectorize.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_VECTORIZE_H
+#define FIT_GUARD_FUNCTION_VECTORIZE_H
+
+/// vectorize
+/// =========
+///
+/// Description
+/// -----------
+///
+/// The `vectorize` function adaptor lifts a function over elements into a
+/// function over contiguous arrays. It takes an output array followed by the
+/// input arrays, and stores `f(ins[i]...)` into `out[i]` for every element.
+/// The arrays can be any type with `data()` and `size()`, such as
+/// `std::vector` or `std::array`. The number of elements processed is the
+/// smallest of the sizes of the arrays.
+///
+/// If the function can be called with the SIMD vector types given by `simd`
+/// for each element type, and it returns the vector type of the output
+/// element, then the arrays are processed in batches of `simd<T>::lanes`
+/// elements. The remaining elements are processed one at a time. Otherwise,
+/// every element is processed one at a time. So generic functions such as
+/// placeholder expressions, like `_1 * _2 + _3`, are vectorized, and functions
+/// that only accept scalars still work. Since vector comparisons produce masks
+/// of `-1` rather than `bool`, functions that return `bool` when called with
+/// scalars, and placeholder expressions that use comparison or logical
+/// operators anywhere, are always processed one element at a time. Other
+/// functions that use a comparison result as a number, such as
+/// `[](auto x, auto y) { return (x > y) + x; }`, can't be detected and give
+/// different results for the batches than for the remaining elements, so
+/// they should convert the comparison explicitly, for example with `x > y ? 1 : 0`.
+///
+/// The vector types use the compiler's vector extensions, which can be
+/// checked with `FIT_HAS_VECTOR_EXTENSIONS`. The vector width is given by
+/// `FIT_SIMD_BYTES`, which defaults to the widest vector registers the target
+/// supports (for example 16 bytes for SSE2 or NEON and 32 bytes for AVX2). If
+/// vector extensions are unavailable, `vectorize` always processes one
+/// element at a time.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     constexpr vectorize_adaptor<F> vectorize(F f);
+///
+///     template<class T>
+///     struct simd
+///     {
+///         typedef ... type;
+///         static constexpr std::size_t lanes = ...;
+///     };
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     std::vector<float> x = {1, 2, 3, 4, 5};
+///     std::vector<float> y = {5, 4, 3, 2, 1};
+///     std::vector<float> out(5);
+///     fit::vectorize(fit::_1 * fit::_2 + fit::_1)(out, x, y);
+///     assert(out[4] == 10);
+///
+
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
+#include <fit/always.h>
+#include <fit/detail/and.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/holder.h>
+#include <fit/detail/make.h>
+#include <fit/detail/move.h>
+#include <fit/detail/static_const_var.h>
+
+#ifndef FIT_HAS_VECTOR_EXTENSIONS
+#if defined(__GNUC__) || defined(__clang__)
+#define FIT_HAS_VECTOR_EXTENSIONS 1
+#else
+#define FIT_HAS_VECTOR_EXTENSIONS 0
+#endif
+#endif
+
+#ifndef FIT_SIMD_BYTES
+#if defined(__AVX512F__)
+#define FIT_SIMD_BYTES 64
+#elif defined(__AVX__)
+#define FIT_SIMD_BYTES 32
+#else
+#define FIT_SIMD_BYTES 16
+#endif
+#endif
+
+namespace fit {
+
+namespace operators {
+
+struct greater_than;
+struct less_than;
+struct less_than_equal;
+struct greater_than_equal;
+struct equal;
+struct not_equal;
+struct and_;
+struct or_;
+struct not_;
+
+}
+
+namespace detail {
+
+template<class F, class Pack>
+struct lazy_invoker;
+
+template<class Seq, class... Ts>
+struct pack_base;
+
+template<class F>
+struct is_simd_mask_op
+: std::false_type
+{};
+
+#define FIT_SIMD_MASK_OP(name) \
+    template<> \
+    struct is_simd_mask_op<operators::name> \
+    : std::true_type \
+    {};
+
+FIT_SIMD_MASK_OP(greater_than)
+FIT_SIMD_MASK_OP(less_than)
+FIT_SIMD_MASK_OP(less_than_equal)
+FIT_SIMD_MASK_OP(greater_than_equal)
+FIT_SIMD_MASK_OP(equal)
+FIT_SIMD_MASK_OP(not_equal)
+FIT_SIMD_MASK_OP(and_)
+FIT_SIMD_MASK_OP(or_)
+FIT_SIMD_MASK_OP(not_)
+
+#undef FIT_SIMD_MASK_OP
+
+// Checks for lazy expressions that would produce a mask when called with
+// vectors
+template<class F>
+struct simd_has_mask
+: is_simd_mask_op<F>
+{};
+
+template<class F, class Pack>
+struct simd_has_mask<lazy_invoker<F, Pack>>
+: std::integral_constant<bool, simd_has_mask<F>::value || simd_has_mask<Pack>::value>
+{};
+
+template<class Seq, class... Ts>
+struct simd_has_mask<pack_base<Seq, Ts...>>
+: std::integral_constant<bool, !and_<std::integral_constant<bool, !simd_has_mask<Ts>::value>...>::value>
+{};
+
+template<class T>
+struct is_simd_element
+: std::integral_constant<bool,
+    FIT_HAS_VECTOR_EXTENSIONS &&
+    ((std::is_integral<T>::value && !std::is_same<T, bool>::value) ||
+    std::is_same<T, float>::value ||
+    std::is_same<T, double>::value) &&
+    (FIT_SIMD_BYTES / sizeof(T) > 1)
+>
+{};
+
+}
+
+template<class T, class=void>
+struct simd
+{
+    typedef T type;
+    static constexpr std::size_t lanes = 1;
+};
+
+template<class T, class Enable>
+constexpr std::size_t simd<T, Enable>::lanes;
+
+#if FIT_HAS_VECTOR_EXTENSIONS
+template<class T>
+struct simd<T, typename std::enable_if<detail::is_simd_element<T>::value>::type>
+{
+    typedef T type __attribute__((vector_size(FIT_SIMD_BYTES)));
+    static constexpr std::size_t lanes = FIT_SIMD_BYTES / sizeof(T);
+};
+
+template<class T>
+constexpr std::size_t simd<T, typename std::enable_if<detail::is_simd_element<T>::value>::type>::lanes;
+#endif
+
+namespace detail {
+
+template<class T>
+struct vectorize_element
+{
+    typedef typename std::remove_cv<typename std::remove_pointer<
+        decltype(std::declval<T&>().data())
+    >::type>::type type;
+};
+
+template<class F, class Out, class Ins, class=void>
+struct vectorize_is_simd_callable
+: std::false_type
+{};
+
+template<class F, class Out, class... Ins>
+struct vectorize_is_simd_callable<F, Out, void(Ins...), typename holder<
+    decltype(std::declval<const F&>()(std::declval<typename simd<Ins>::type>()...))
+>::type>
+: std::is_same<
+    typename std::decay<decltype(std::declval<const F&>()(std::declval<typename simd<Ins>::type>()...))>::type,
+    typename simd<Out>::type
+>
+{};
+
+// A function that returns bool for scalars returns a mask for vectors
+template<class F, class... Ins>
+struct vectorize_returns_bool
+: std::is_same<
+    typename std::decay<decltype(std::declval<const F&>()(std::declval<const Ins&>()...))>::type,
+    bool
+>
+{};
+
+template<std::size_t N, std::size_t... Ns>
+struct vectorize_same_lanes
+: and_<std::integral_constant<bool, N == Ns>...>
+{};
+
+template<class F, class Out, class... Ins>
+struct vectorize_can_simd
+: std::integral_constant<bool,
+    is_simd_element<Out>::value &&
+    and_<is_simd_element<Ins>...>::value &&
+    vectorize_same_lanes<simd<Out>::lanes, simd<Ins>::lanes...>::value &&
+    !simd_has_mask<F>::value &&
+    !vectorize_returns_bool<F, Ins...>::value &&
+    vectorize_is_simd_callable<F, Out, void(Ins...)>::value
+>
+{};
+
+constexpr std::size_t vectorize_min(std::size_t n)
+{
+    return n;
+}
+
+template<class... Ts>
+constexpr std::size_t vectorize_min(std::size_t n, std::size_t m, Ts... ms)
+{
+    return vectorize_min(n < m ? n : m, ms...);
+}
+
+template<class V, class T>
+V vectorize_load(const T* p)
+{
+    V v;
+    std::memcpy(&v, p, sizeof(V));
+    return v;
+}
+
+template<class T, class V>
+void vectorize_store(T* p, const V& v)
+{
+    std::memcpy(p, &v, sizeof(V));
+}
+
+template<class F, class Out, class... Ins>
+void vectorize_scalar(const F& f, std::size_t i, std::size_t n, Out* out, const Ins*... ins)
+{
+    for(; i < n; i++) out[i] = f(ins[i]...);
+}
+
+template<class F, class Out, class... Ins>
+void vectorize_run(std::false_type, const F& f, std::size_t n, Out* out, const Ins*... ins)
+{
+    vectorize_scalar(f, 0, n, out, ins...);
+}
+
+template<class F, class Out, class... Ins>
+void vectorize_run(std::true_type, const F& f, std::size_t n, Out* out, const Ins*... ins)
+{
+    const std::size_t lanes = simd<Out>::lanes;
+    std::size_t i = 0;
+    for(; i + lanes <= n; i += lanes)
+    {
+        vectorize_store(out + i, f(vectorize_load<typename simd<Ins>::type>(ins + i)...));
+    }
+    vectorize_scalar(f, i, n, out, ins...);
+}
+
+}
+
+template<class F>
+struct vectorize_adaptor : F
+{
+    typedef vectorize_adaptor fit_rewritable1_tag;
+    FIT_INHERIT_CONSTRUCTOR(vectorize_adaptor, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class Out, class... Ins>
+    void operator()(Out&& out, Ins&&... ins) const
+    {
+        typedef detail::vectorize_can_simd<F,
+            typename detail::vectorize_element<Out>::type,
+            typename detail::vectorize_element<Ins>::type...
+        > can_simd;
+        detail::vectorize_run(
+            std::integral_constant<bool, can_simd::value>(),
+            this->base_function(out),
+            detail::vectorize_min(out.size(), ins.size()...),
+            out.data(),
+            ins.data()...
+        );
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(vectorize, detail::make<vectorize_adaptor>);
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+/*=============================================================================
+    Copyright (c) 2015 Paul Fultz II
+    visit.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_VISIT_H
+#define FIT_GUARD_FUNCTION_VISIT_H
+
+/// visit
+/// =====
+///
+/// Description
+/// -----------
+///
+/// The `visit` function adaptor calls the function with the active
+/// alternatives of each `std::variant` passed to it. The function is
+/// dispatched through a table of function pointers that is built at
+/// compile-time and indexed by `index()`, so each call is a single indirect
+/// call no matter how many alternatives there are. When several variants are
+/// passed, a single flattened table is used for all of their combinations.
+///
+/// The `visit_match` function is a shorthand for using `visit` with the
+/// `match` adaptor, so the overload for each alternative can be written
+/// inline.
+///
+/// Just like `std::visit`, the function must return the same type for every
+/// combination of alternatives, and `std::bad_variant_access` is thrown if
+/// any of the variants is valueless.
+///
+/// This requires `std::variant`, which can be checked with
+/// `FIT_HAS_VARIANT`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     constexpr visit_adaptor<F> visit(F f);
+///
+///     template<class Variant, class... Fs>
+///     constexpr auto visit_match(Variant&& v, Fs... fs);
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+///     FunctionObject
+///     MoveConstructible
+///
+/// Example
+/// -------
+///
+///     std::variant<int, std::string> v = std::string("hello");
+///     int r = fit::visit_match(v,
+///         [](int x) { return x; },
+///         [](const std::string& s) { return int(s.size()); }
+///     );
+///     assert(r == 5);
+///
+
+#ifndef FIT_HAS_VARIANT
+#if defined(__has_include)
+#if __has_include(<variant>) && __cplusplus >= 201703L
+#define FIT_HAS_VARIANT 1
+#endif
+#endif
+#endif
+
+#ifndef FIT_HAS_VARIANT
+#define FIT_HAS_VARIANT 0
+#endif
+
+#if FIT_HAS_VARIANT
+
+#include <cstddef>
+#include <utility>
+#include <variant>
+#include <fit/always.h>
+#include <fit/match.h>
+#include <fit/detail/delegate.h>
+#include <fit/detail/move.h>
+#include <fit/detail/make.h>
+#include <fit/detail/static_const_var.h>
+
+namespace fit {
+
+namespace detail {
+
+template<class V>
+struct visit_size
+: std::variant_size<typename std::remove_cv<typename std::remove_reference<V>::type>::type>
+{};
+
+// Computes the index of the Nth variant from the flattened table index
+template<std::size_t N, class... Vs>
+constexpr std::size_t visit_unflatten(std::size_t k)
+{
+    constexpr std::size_t sizes[] = { visit_size<Vs>::value... };
+    std::size_t stride = 1;
+    for(std::size_t i = N + 1; i < sizeof...(Vs); i++) stride *= sizes[i];
+    return (k / stride) % sizes[N];
+}
+
+template<class... Vs>
+constexpr std::size_t visit_flatten(const Vs&... vs)
+{
+    constexpr std::size_t sizes[] = { visit_size<Vs>::value... };
+    const std::size_t indices[] = { vs.index()... };
+    std::size_t k = 0;
+    for(std::size_t i = 0; i < sizeof...(Vs); i++) k = k * sizes[i] + indices[i];
+    return k;
+}
+
+template<class F, class... Vs>
+struct visit_table
+{
+    typedef decltype(std::declval<const F&>()(std::get<0>(std::declval<Vs>())...)) result_type;
+    typedef result_type (*function_pointer)(const F&, Vs&&...);
+
+    static constexpr std::size_t size = (visit_size<Vs>::value * ... * 1);
+
+    template<std::size_t K, std::size_t... Ns>
+    static constexpr result_type call(const F& f, Vs&&... vs, std::index_sequence<Ns...>)
+    {
+        return f(std::get<visit_unflatten<Ns, Vs...>(K)>(fit::forward<Vs>(vs))...);
+    }
+
+    template<std::size_t K>
+    static constexpr result_type thunk(const F& f, Vs&&... vs)
+    {
+        return call<K>(f, fit::forward<Vs>(vs)..., std::index_sequence_for<Vs...>());
+    }
+
+    template<std::size_t... Ks>
+    static constexpr const function_pointer* make(std::index_sequence<Ks...>)
+    {
+        return table<Ks...>;
+    }
+
+    template<std::size_t... Ks>
+    static constexpr function_pointer table[] = { &thunk<Ks>... };
+};
+
+}
+
+template<class F>
+struct visit_adaptor : F
+{
+    typedef visit_adaptor fit_rewritable1_tag;
+    FIT_INHERIT_CONSTRUCTOR(visit_adaptor, F);
+
+    template<class... Ts>
+    constexpr const F& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Vs, class Table=detail::visit_table<F, Vs...>>
+    constexpr typename Table::result_type operator()(Vs&&... vs) const
+    {
+        if ((vs.valueless_by_exception() || ...)) throw std::bad_variant_access();
+        return Table::make(std::make_index_sequence<Table::size>())[detail::visit_flatten(vs...)]
+            (this->base_function(vs...), fit::forward<Vs>(vs)...);
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(visit, detail::make<visit_adaptor>);
+
+namespace detail {
+
+struct visit_match_f
+{
+    template<class V, class... Fs>
+    constexpr auto operator()(V&& v, Fs... fs) const FIT_RETURNS
+    (
+        visit_adaptor<match_adaptor<Fs...>>(fit::move(fs)...)(fit::forward<V>(v))
+    );
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(visit_match, detail::visit_match_f);
+
+}
+
+#endif
+
+#endif
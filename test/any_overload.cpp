@@ -0,0 +1,107 @@
+#include <fit/any_overload.h>
+#include <fit/match.h>
+#include "test.h"
+
+#include <array>
+#include <string>
+
+struct int_f
+{
+    int operator()(int x) const
+    {
+        return x;
+    }
+};
+
+struct double_f
+{
+    int operator()(double x) const
+    {
+        return static_cast<int>(x * 10);
+    }
+};
+
+struct string_f
+{
+    int operator()(const std::string& s) const
+    {
+        return s.size();
+    }
+};
+
+struct big_f
+{
+    std::array<int, 16> data;
+    int operator()(int x) const
+    {
+        return data[0] + x;
+    }
+    int operator()(const std::string& s) const
+    {
+        return data[1] + s.size();
+    }
+};
+
+struct visitor_unique
+{
+    std::unique_ptr<int> p;
+    int operator()(int x) const
+    {
+        return *p + x;
+    }
+    int operator()(const std::string& s) const
+    {
+        return *p + s.size();
+    }
+};
+
+typedef fit::any_overload<int(int), int(double), int(const std::string&)> visitor;
+
+STATIC_ASSERT_MOVE_ONLY(visitor);
+static_assert(sizeof(visitor) == sizeof(fit::unique_function<int(int)>), "Not a single buffer and table");
+static_assert(!std::is_constructible<visitor, int_f>::value, "Missing overloads");
+
+FIT_TEST_CASE()
+{
+    visitor v = fit::match(int_f(), double_f(), string_f());
+    FIT_TEST_CHECK(v);
+    FIT_TEST_CHECK(v(3) == 3);
+    FIT_TEST_CHECK(v(1.5) == 15);
+    FIT_TEST_CHECK(v(std::string("hello")) == 5);
+    FIT_TEST_CHECK(v("hi") == 2);
+    visitor w = fit::move(v);
+    FIT_TEST_CHECK(!v);
+    FIT_TEST_CHECK(w(2.5) == 25);
+}
+
+FIT_TEST_CASE()
+{
+    big_f b = {};
+    b.data[0] = 1;
+    b.data[1] = 2;
+    fit::any_overload<int(int), int(const std::string&)> f = b;
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(f(std::string("abc")) == 5);
+    auto g = fit::move(f);
+    FIT_TEST_CHECK(g(1) == 2);
+    g = fit::match(int_f(), string_f());
+    FIT_TEST_CHECK(g(1) == 1);
+}
+
+FIT_TEST_CASE()
+{
+    fit::any_overload<int(int), int(const std::string&)> f = visitor_unique{std::unique_ptr<int>(new int(1))};
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(f(std::string("abc")) == 4);
+    f = nullptr;
+    bool thrown = false;
+    try
+    {
+        f(1);
+    }
+    catch(const std::bad_function_call&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+}
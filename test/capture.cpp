@@ -1,5 +1,7 @@
 #include "test.h"
 #include <fit/capture.h>
+#include <memory>
+#include <string>
 
 // TODO: Test empty capture
 
@@ -25,4 +27,92 @@ FIT_TEST_CASE()
 
     FIT_STATIC_TEST_CHECK(fit::capture_decay(1)(binary_class())(2) == 3);
     FIT_TEST_CHECK(fit::capture_decay(1)(binary_class())(2) == 3);
-}
\ No newline at end of file
+}
+
+struct add_unique
+{
+    int operator()(const std::unique_ptr<int>& i, int x) const
+    {
+        return *i + x;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto f = fit::capture(std::unique_ptr<int>(new int(1)))(add_unique());
+    FIT_TEST_CHECK(f(2) == 3);
+    FIT_TEST_CHECK(f(2) == 3);
+    auto g = fit::move(f);
+    FIT_TEST_CHECK(g(2) == 3);
+    FIT_TEST_CHECK(g(2) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::capture(std::string("hello"))([](std::string s) { return s; });
+    FIT_TEST_CHECK(f() == "hello");
+    FIT_TEST_CHECK(f() == "hello");
+}
+
+struct is_const_lvalue
+{
+    template<class T>
+    constexpr bool operator()(T&&) const
+    {
+        return std::is_same<T, const std::unique_ptr<int>&>::value;
+    }
+};
+
+// Move-only captured values are passed as const lvalues
+FIT_TEST_CASE()
+{
+    auto f = fit::capture(std::unique_ptr<int>(new int(1)))(is_const_lvalue());
+    FIT_TEST_CHECK(f());
+    FIT_TEST_CHECK(f());
+}
+
+struct copy_counter
+{
+    static int copies;
+    static int moves;
+
+    copy_counter()
+    {}
+
+    copy_counter(const copy_counter&)
+    {
+        copies++;
+    }
+
+    copy_counter(copy_counter&&)
+    {
+        moves++;
+    }
+};
+
+int copy_counter::copies = 0;
+int copy_counter::moves = 0;
+
+struct is_rvalue
+{
+    template<class T>
+    bool operator()(T&&) const
+    {
+        return !std::is_reference<T>::value;
+    }
+};
+
+// Each call copies a copyable captured value and passes the copy as an
+// rvalue, leaving the captured value alone
+FIT_TEST_CASE()
+{
+    auto f = fit::capture(copy_counter())(is_rvalue());
+    copy_counter::copies = 0;
+    copy_counter::moves = 0;
+    FIT_TEST_CHECK(f());
+    FIT_TEST_CHECK(copy_counter::copies == 1);
+    FIT_TEST_CHECK(copy_counter::moves == 2);
+    FIT_TEST_CHECK(f());
+    FIT_TEST_CHECK(copy_counter::copies == 2);
+    FIT_TEST_CHECK(copy_counter::moves == 4);
+}
@@ -0,0 +1,17 @@
+# Fails if any of the object files has a dynamic initializer
+
+foreach(OBJECT ${OBJECTS})
+    execute_process(COMMAND ${NM} ${OBJECT} OUTPUT_VARIABLE SYMBOLS RESULT_VARIABLE RESULT)
+    if(NOT RESULT EQUAL 0)
+        message(FATAL_ERROR "Failed to read the symbols of ${OBJECT}")
+    endif()
+    if(SYMBOLS MATCHES "_GLOBAL__sub_I|_GLOBAL__I_")
+        message(FATAL_ERROR "Dynamic initializer found in ${OBJECT}:\n${SYMBOLS}")
+    endif()
+    if(OBJDUMP)
+        execute_process(COMMAND ${OBJDUMP} -h ${OBJECT} OUTPUT_VARIABLE SECTIONS RESULT_VARIABLE RESULT)
+        if(RESULT EQUAL 0 AND SECTIONS MATCHES "\\.init_array|\\.ctors")
+            message(FATAL_ERROR "Dynamic initializer found in ${OBJECT}:\n${SECTIONS}")
+        endif()
+    endif()
+endforeach()
@@ -0,0 +1,15 @@
+#include "constinit.h"
+#include "test.h"
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit_test::constinit_static_function(1, 2) == 3);
+    FIT_TEST_CHECK(fit_test::constinit_static_lambda(1, 2) == 3);
+    FIT_TEST_CHECK(fit_test::constinit_static_var(1, 2) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit_test::constinit_static(3) == 6);
+    FIT_TEST_CHECK(fit_test::constinit_adaptors(1) == 5);
+}
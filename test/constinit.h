@@ -0,0 +1,100 @@
+
+#ifndef GUARD_CONSTINIT
+#define GUARD_CONSTINIT
+
+// Every header, so that none of them can add a dynamic initializer
+#include <fit/alias.h>
+#include <fit/always.h>
+#include <fit/any_overload.h>
+#include <fit/apply.h>
+#include <fit/apply_eval.h>
+#include <fit/args.h>
+#include <fit/by.h>
+#include <fit/capture.h>
+#include <fit/combine.h>
+#include <fit/compose.h>
+#include <fit/compress.h>
+#include <fit/conditional.h>
+#include <fit/construct.h>
+#include <fit/decay.h>
+#include <fit/eval.h>
+#include <fit/eval_columns.h>
+#include <fit/fix.h>
+#include <fit/flip.h>
+#include <fit/flow.h>
+#include <fit/function.h>
+#include <fit/function_ref.h>
+#include <fit/identity.h>
+#include <fit/if.h>
+#include <fit/implicit.h>
+#include <fit/indirect.h>
+#include <fit/infix.h>
+#include <fit/is_callable.h>
+#include <fit/lambda.h>
+#include <fit/lazy.h>
+#include <fit/lift.h>
+#include <fit/make_table.h>
+#include <fit/match.h>
+#include <fit/memo_fix.h>
+#include <fit/mutable.h>
+#include <fit/pack.h>
+#include <fit/parallel_apply_eval.h>
+#include <fit/parallel_combine.h>
+#include <fit/partial.h>
+#include <fit/permute.h>
+#include <fit/pipable.h>
+#include <fit/pipeline.h>
+#include <fit/placeholders.h>
+#include <fit/profile.h>
+#include <fit/protect.h>
+#include <fit/range.h>
+#include <fit/reduce.h>
+#include <fit/repeat.h>
+#include <fit/repeat_while.h>
+#include <fit/result.h>
+#include <fit/returns.h>
+#include <fit/reveal.h>
+#include <fit/reverse_compress.h>
+#include <fit/rotate.h>
+#include <fit/sort_by.h>
+#include <fit/static.h>
+#include <fit/tap.h>
+#include <fit/thread_pool.h>
+#include <fit/trace.h>
+#include <fit/trampoline_fix.h>
+#include <fit/unique_function.h>
+#include <fit/unpack.h>
+#include <fit/unpack_n.h>
+#include <fit/vectorize.h>
+#include <fit/visit.h>
+
+namespace fit_test {
+
+struct constinit_sum_f
+{
+    constexpr int operator()(int x, int y) const
+    {
+        return x + y;
+    }
+};
+
+struct constinit_times_f
+{
+    int factor;
+    constinit_times_f() : factor(2)
+    {}
+    int operator()(int x) const
+    {
+        return x * factor;
+    }
+};
+
+int constinit_static_function(int x, int y);
+int constinit_static_lambda(int x, int y);
+int constinit_static_var(int x, int y);
+int constinit_static(int x);
+int constinit_adaptors(int x);
+
+}
+
+#endif
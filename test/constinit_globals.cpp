@@ -0,0 +1,54 @@
+
+#include "constinit.h"
+
+// This file must not have a dynamic initializer, which the build checks by
+// looking for one in its object file. So it can't use test.h, since the test
+// cases register themselves at startup.
+
+namespace fit_test {
+
+FIT_STATIC_FUNCTION(constinit_sum) = constinit_sum_f();
+
+FIT_STATIC_LAMBDA_FUNCTION(constinit_sum_lambda) = [](int x, int y)
+{
+    return x + y;
+};
+
+FIT_DECLARE_STATIC_VAR(constinit_sum_var, constinit_sum_f);
+
+FIT_CONSTINIT fit::static_<constinit_times_f> constinit_times = {};
+
+FIT_CONSTINIT const auto& constinit_flow = fit::flow;
+
+FIT_CONSTINIT const fit::partial_adaptor<constinit_sum_f> constinit_partial = {};
+
+FIT_CONSTINIT const fit::pipable_adaptor<constinit_sum_f> constinit_pipable = {};
+
+FIT_CONSTINIT const fit::conditional_adaptor<constinit_sum_f, fit::detail::identity_base> constinit_conditional = {};
+
+int constinit_static_function(int x, int y)
+{
+    return constinit_sum(x, y);
+}
+
+int constinit_static_lambda(int x, int y)
+{
+    return constinit_sum_lambda(x, y);
+}
+
+int constinit_static_var(int x, int y)
+{
+    return constinit_sum_var(x, y);
+}
+
+int constinit_static(int x)
+{
+    return constinit_times(x);
+}
+
+int constinit_adaptors(int x)
+{
+    return constinit_flow(constinit_partial(x), fit::identity)(x) + (x | constinit_pipable(x)) + constinit_conditional(x);
+}
+
+}
@@ -0,0 +1,123 @@
+#include <fit/eval_columns.h>
+#include <fit/placeholders.h>
+#include "test.h"
+
+#include <array>
+#include <vector>
+
+struct scalar_square
+{
+    float operator()(float x) const
+    {
+        return x * x;
+    }
+};
+
+struct generic_max
+{
+    template<class T>
+    T operator()(T x, T y) const
+    {
+        return x > y ? x : y;
+    }
+};
+
+struct vector_counter
+{
+    static int batches;
+
+    float operator()(float x) const
+    {
+        return x + 1;
+    }
+
+    fit::simd<float>::type operator()(fit::simd<float>::type x) const
+    {
+        batches++;
+        return x + 1;
+    }
+};
+
+int vector_counter::batches = 0;
+
+static_assert(fit::detail::simd_has_mask<decltype(fit::_1 * fit::_2 > fit::_3)>::value, "Mask not detected");
+static_assert(!fit::detail::simd_has_mask<decltype(fit::_1 * fit::_2 + fit::_3)>::value, "Mask detected");
+
+template<class T>
+std::vector<T> iota_column(std::size_t n, T start)
+{
+    std::vector<T> result;
+    for(std::size_t i=0;i<n;i++) result.push_back(start + T(i % 17));
+    return result;
+}
+
+FIT_TEST_CASE()
+{
+    const std::size_t n = 3*FIT_EVAL_COLUMNS_BLOCK + 5;
+    auto x = iota_column<float>(n, 1);
+    auto y = iota_column<float>(n, 2);
+    auto z = iota_column<float>(n, 3);
+    std::vector<float> out(n);
+    fit::eval_columns(fit::_1 * fit::_2 + fit::_3, out, x, y, z);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == x[i] * y[i] + z[i]);
+    fit::eval_columns(fit::_2, out, x, y);
+    FIT_TEST_CHECK(out == y);
+    fit::eval_columns(fit::lazy(fit::operators::multiply())(fit::_1 - 1.0f, 2.0f), out, x);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == (x[i] - 1.0f) * 2.0f);
+}
+
+FIT_TEST_CASE()
+{
+    // A scalar-only function at the top evaluates its children into blocks
+    const std::size_t n = 2*FIT_EVAL_COLUMNS_BLOCK + 1;
+    auto x = iota_column<float>(n, 1);
+    auto y = iota_column<float>(n, 2);
+    std::vector<float> out(n);
+    fit::eval_columns(fit::lazy(scalar_square())(fit::_1 + fit::_2), out, x, y);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == (x[i] + y[i]) * (x[i] + y[i]));
+    fit::eval_columns(fit::lazy(generic_max())(fit::_1 * 2.0f, fit::_2), out, x, y);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == (x[i] * 2 > y[i] ? x[i] * 2 : y[i]));
+}
+
+FIT_TEST_CASE()
+{
+    const std::size_t n = FIT_EVAL_COLUMNS_BLOCK + 3;
+    auto x = iota_column<int>(n, -8);
+    auto y = iota_column<int>(n, 0);
+    std::vector<int> out(n);
+    fit::eval_columns(fit::lazy(fit::operators::greater_than())(fit::_1 * fit::_2, fit::_2 + 10), out, x, y);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == (x[i] * y[i] > y[i] + 10 ? 1 : 0));
+    fit::eval_columns(fit::lazy(fit::operators::add())(fit::_1 < 0, fit::lazy(fit::operators::multiply())(fit::_2 > 3, 2)), out, x, y);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == (x[i] < 0) + (y[i] > 3) * 2);
+    int k = 3;
+    fit::eval_columns(fit::_1 + std::cref(k), out, x);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == x[i] + 3);
+    fit::eval_columns(fit::lazy_hoist(fit::_1 + fit::lazy(fit::operators::multiply())(2, 3)), out, x);
+    for(std::size_t i=0;i<n;i++) FIT_TEST_CHECK(out[i] == x[i] + 6);
+}
+
+FIT_TEST_CASE()
+{
+    std::array<float, 10> x;
+    x.fill(1);
+    std::array<float, 10> out;
+    vector_counter::batches = 0;
+    fit::eval_columns(fit::lazy(vector_counter())(fit::_1), out, x);
+    for(float r:out) FIT_TEST_CHECK(r == 2);
+#if FIT_HAS_VECTOR_EXTENSIONS
+    FIT_TEST_CHECK(vector_counter::batches == int(10 / fit::simd<float>::lanes));
+#endif
+}
+
+FIT_TEST_CASE()
+{
+    // Vectorizable children of a scalar-only function are still vectorized
+    const std::size_t n = FIT_EVAL_COLUMNS_BLOCK * 2;
+    std::vector<float> x(n, 2), out(n);
+    vector_counter::batches = 0;
+    fit::eval_columns(fit::lazy(scalar_square())(fit::lazy(vector_counter())(fit::_1)), out, x);
+    for(float r:out) FIT_TEST_CHECK(r == 9);
+#if FIT_HAS_VECTOR_EXTENSIONS
+    FIT_TEST_CHECK(vector_counter::batches == int(n / fit::simd<float>::lanes));
+#endif
+}
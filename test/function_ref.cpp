@@ -0,0 +1,94 @@
+#include <fit/function_ref.h>
+#include <fit/compose.h>
+#include <fit/partial.h>
+#include <fit/lazy.h>
+#include <fit/placeholders.h>
+#include "test.h"
+
+static_assert(std::is_trivially_copyable<fit::function_ref<int(int)>>::value, "Not trivially copyable");
+static_assert(sizeof(fit::function_ref<int(int)>) == 2*sizeof(void*), "Not two pointers");
+
+static constexpr mono_class mono = {};
+static constexpr fit::function_ref<int(int)> mono_ref = mono;
+
+int apply_twice(fit::function_ref<int(int)> f, int x)
+{
+    return f(f(x));
+}
+
+int times_two(int x)
+{
+    return x*2;
+}
+
+struct counter
+{
+    int* count;
+    void operator()(int x) const
+    {
+        *count += x;
+    }
+};
+
+struct copy_counter
+{
+    int* copies;
+    copy_counter(int* c) : copies(c)
+    {}
+    copy_counter(const copy_counter& rhs) : copies(rhs.copies)
+    {
+        ++*copies;
+    }
+    int operator()(int x) const
+    {
+        return x;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(mono_ref(1) == 2);
+    FIT_TEST_CHECK(apply_twice(mono, 1) == 3);
+    FIT_TEST_CHECK(apply_twice(fit::compose(mono_class(), mono_class()), 1) == 5);
+    FIT_TEST_CHECK(apply_twice(fit::partial(binary_class())(2), 1) == 5);
+    FIT_TEST_CHECK(apply_twice(fit::lazy(binary_class())(fit::_1, 3), 1) == 7);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(apply_twice(times_two, 3) == 12);
+    FIT_TEST_CHECK(apply_twice(&times_two, 3) == 12);
+    int (*fp)(int) = times_two;
+    FIT_TEST_CHECK(apply_twice(fp, 3) == 12);
+}
+
+FIT_TEST_CASE()
+{
+    int count = 0;
+    counter c = { &count };
+    fit::function_ref<void(int)> f = c;
+    f(2);
+    f(3);
+    FIT_TEST_CHECK(count == 5);
+    // Return values can be discarded
+    fit::function_ref<void(int)> g = mono;
+    g(1);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    copy_counter c(&copies);
+    fit::function_ref<int(int)> f = c;
+    fit::function_ref<int(int)> f2 = f;
+    FIT_TEST_CHECK(f2(3) == 3);
+    FIT_TEST_CHECK(copies == 0);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = [](std::unique_ptr<int> p) { return *p; };
+    fit::function_ref<int(std::unique_ptr<int>)> r = f;
+    FIT_TEST_CHECK(r(std::unique_ptr<int>(new int(3))) == 3);
+    static_assert(!std::is_constructible<fit::function_ref<int(std::string)>, mono_class>::value, "Not callable");
+}
@@ -27,6 +27,9 @@ constexpr wrapper<T> wrap(T x)
 FIT_TEST_CASE()
 {
     FIT_TEST_CHECK(3 == add_one(2));
+#if FIT_HAS_CONSTEXPR_LAMBDA
+    FIT_STATIC_TEST_CHECK(3 == add_one(2));
+#endif
 }
 
 FIT_TEST_CASE()
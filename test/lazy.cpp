@@ -163,3 +163,85 @@ FIT_TEST_CASE()
 {
     FIT_TEST_CHECK(fit::lazy(deref())(std::unique_ptr<int>(new int(3)))() == 3);
 }
+
+struct counted_square
+{
+    static int calls;
+    int operator()(int x) const
+    {
+        calls++;
+        return x * x;
+    }
+};
+
+int counted_square::calls = 0;
+
+struct add_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    using std::placeholders::_1;
+    using std::placeholders::_2;
+    counted_square::calls = 0;
+    auto e = fit::lazy(add_f())(fit::lazy(counted_square())(fit::lazy(add_f())(40, 2)), _1);
+    auto f = fit::lazy_hoist(e);
+    FIT_TEST_CHECK(counted_square::calls == 1);
+    FIT_TEST_CHECK(f(1) == 1765);
+    FIT_TEST_CHECK(f(2) == 1766);
+    FIT_TEST_CHECK(counted_square::calls == 1);
+    FIT_TEST_CHECK(e(1) == f(1));
+    FIT_TEST_CHECK(counted_square::calls == 2);
+
+    auto g = fit::lazy_hoist(fit::lazy(add_f())(fit::lazy(counted_square())(_2), fit::lazy(counted_square())(3)));
+    FIT_TEST_CHECK(counted_square::calls == 3);
+    FIT_TEST_CHECK(g(0, 2) == 13);
+    FIT_TEST_CHECK(counted_square::calls == 4);
+
+    auto h = fit::lazy_hoist(fit::lazy(counted_square())(4));
+    FIT_TEST_CHECK(counted_square::calls == 5);
+    FIT_TEST_CHECK(h() == 16);
+    FIT_TEST_CHECK(h(1, 2) == 16);
+    FIT_TEST_CHECK(counted_square::calls == 5);
+    static_assert(std::is_bind_expression<decltype(h)>::value, "Not a bind expression");
+}
+
+FIT_TEST_CASE()
+{
+    using std::placeholders::_1;
+    int x = 1;
+    auto f = fit::lazy_hoist(fit::lazy(add_f())(std::ref(x), fit::lazy(add_f())(_1, 2)));
+    FIT_TEST_CHECK(f(1) == 4);
+    x = 5;
+    FIT_TEST_CHECK(f(1) == 8);
+    auto g = fit::lazy_hoist(fit::lazy(add_f())(1, 2));
+    FIT_STATIC_TEST_CHECK(fit::lazy_hoist(fit::lazy(add_f())(1, 2))() == 3);
+    FIT_TEST_CHECK(g() == 3);
+}
+
+// Subexpressions that read a reference_wrapper are not hoisted
+FIT_TEST_CASE()
+{
+    using std::placeholders::_1;
+    counted_square::calls = 0;
+    int x = 1;
+    const int& cx = x;
+    auto e = fit::lazy(add_f())(fit::lazy(counted_square())(std::ref(x)), _1);
+    auto f = fit::lazy_hoist(e);
+    auto g = fit::lazy_hoist(fit::lazy(counted_square())(std::cref(cx)));
+    FIT_TEST_CHECK(counted_square::calls == 0);
+    FIT_TEST_CHECK(f(0) == 1);
+    FIT_TEST_CHECK(g() == 1);
+    x = 10;
+    FIT_TEST_CHECK(e(0) == 100);
+    FIT_TEST_CHECK(f(0) == 100);
+    FIT_TEST_CHECK(g() == 100);
+    static_assert(!fit::detail::lazy_is_constant<std::reference_wrapper<int>>::value, "reference_wrapper is constant");
+    static_assert(!fit::detail::lazy_is_constant<const std::reference_wrapper<int>&>::value, "reference_wrapper is constant");
+}
@@ -0,0 +1,89 @@
+#include <fit/make_table.h>
+#include <fit/fix.h>
+#include "test.h"
+
+#include <cstdint>
+
+struct square
+{
+    constexpr std::size_t operator()(std::size_t i) const
+    {
+        return i*i;
+    }
+};
+
+struct crc32_entry
+{
+    static constexpr std::uint32_t step(std::uint32_t c, int k)
+    {
+        return k == 0 ? c : step((c & 1) ? 0xEDB88320u ^ (c >> 1) : (c >> 1), k - 1);
+    }
+    template<class I>
+    constexpr std::uint32_t operator()(I) const
+    {
+        return step(I::value, 8);
+    }
+};
+
+struct bit_reverse_entry
+{
+    static constexpr std::uint8_t reverse(unsigned x, unsigned r, int k)
+    {
+        return k == 0 ? r : reverse(x >> 1, (r << 1) | (x & 1), k - 1);
+    }
+    constexpr std::uint8_t operator()(std::size_t i) const
+    {
+        return reverse(i, 0, 8);
+    }
+};
+
+struct factorial_t
+{
+    template<class Self>
+    constexpr std::size_t operator()(Self s, std::size_t x) const
+    {
+        return x == 0 ? 1 : x * s(x-1);
+    }
+};
+
+static constexpr auto squares = fit::make_table<16>(square());
+static constexpr auto crc_table = fit::make_table<256>(crc32_entry());
+static constexpr auto bit_reverse_table = fit::make_table<256>(bit_reverse_entry());
+#if FIT_FIX_HAS_CONSTEXPR
+static constexpr auto factorials = fit::make_table<10>(fit::fix_adaptor<factorial_t>());
+#endif
+
+FIT_TEST_CASE()
+{
+    STATIC_ASSERT_SAME(decltype(squares), const std::array<std::size_t, 16>);
+    FIT_STATIC_TEST_CHECK(squares[0] == 0);
+    FIT_STATIC_TEST_CHECK(squares[15] == 225);
+    FIT_TEST_CHECK(squares[7] == 49);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(crc_table[0] == 0);
+    FIT_STATIC_TEST_CHECK(crc_table[1] == 0x77073096u);
+    FIT_STATIC_TEST_CHECK(crc_table[255] == 0x2D02EF8Du);
+    std::uint32_t crc = 0xFFFFFFFFu;
+    for(char c:std::string("123456789")) crc = crc_table[(crc ^ std::uint8_t(c)) & 0xFF] ^ (crc >> 8);
+    FIT_TEST_CHECK((crc ^ 0xFFFFFFFFu) == 0xCBF43926u);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(bit_reverse_table[1] == 0x80);
+    FIT_STATIC_TEST_CHECK(bit_reverse_table[0x0F] == 0xF0);
+    for(std::size_t i=0;i<256;i++) FIT_TEST_CHECK(bit_reverse_table[bit_reverse_table[i]] == i);
+}
+
+FIT_TEST_CASE()
+{
+#if FIT_FIX_HAS_CONSTEXPR
+    FIT_STATIC_TEST_CHECK(factorials[0] == 1);
+    FIT_STATIC_TEST_CHECK(factorials[5] == 120);
+    FIT_STATIC_TEST_CHECK(factorials[9] == 362880);
+#endif
+    FIT_STATIC_TEST_CHECK(fit::make_table<0>(square()).size() == 0);
+}
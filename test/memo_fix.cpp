@@ -0,0 +1,94 @@
+#include <fit/memo_fix.h>
+#include <fit/fix.h>
+#include "test.h"
+
+#include <algorithm>
+#include <string>
+
+struct fib_t
+{
+    int* calls;
+    fib_t(int* c) : calls(c)
+    {}
+    template<class Self>
+    long long operator()(Self self, int n) const
+    {
+        ++*calls;
+        return n < 2 ? n : self(n-1) + self(n-2);
+    }
+};
+
+struct edit_distance_t
+{
+    std::string a;
+    std::string b;
+    template<class Self>
+    int operator()(Self self, std::size_t i, std::size_t j) const
+    {
+        if (i == 0) return j;
+        if (j == 0) return i;
+        int cost = a[i-1] == b[j-1] ? 0 : 1;
+        int r = self(i-1, j-1) + cost;
+        int d = self(i-1, j) + 1;
+        int s = self(i, j-1) + 1;
+        return std::min(r, std::min(d, s));
+    }
+};
+
+FIT_TEST_CASE()
+{
+    int calls = 0;
+    FIT_TEST_CHECK(fit::fix(fib_t(&calls))(20) == 6765);
+    FIT_TEST_CHECK(calls == 21891);
+    calls = 0;
+    FIT_TEST_CHECK(fit::memo_fix(fib_t(&calls))(20) == 6765);
+    FIT_TEST_CHECK(calls == 21);
+    calls = 0;
+    FIT_TEST_CHECK(fit::memo_fix(fib_t(&calls))(80) == 23416728348467685LL);
+    FIT_TEST_CHECK(calls == 81);
+}
+
+FIT_TEST_CASE()
+{
+    int calls = 0;
+    fit::memo_fix_adaptor<fib_t, fit::memo_dense<100>> fib(&calls);
+    FIT_TEST_CHECK(fib(80) == 23416728348467685LL);
+    FIT_TEST_CHECK(calls == 81);
+    calls = 0;
+    fit::memo_fix_adaptor<fib_t, fit::memo_dense<10>> small_fib(&calls);
+    FIT_TEST_CHECK(small_fib(20) == 6765);
+    FIT_TEST_CHECK(calls < 21891);
+}
+
+FIT_TEST_CASE()
+{
+    int calls = 0;
+    fit::memo_hash_map<long long, int> cache;
+    auto fib = fit::memo_fix(fib_t(&calls)).with_cache(cache);
+    FIT_TEST_CHECK(fib(30) == 832040);
+    FIT_TEST_CHECK(calls == 31);
+    FIT_TEST_CHECK(cache.size() == 31);
+    calls = 0;
+    FIT_TEST_CHECK(fib(31) == 1346269);
+    FIT_TEST_CHECK(calls == 1);
+    cache.clear();
+    calls = 0;
+    FIT_TEST_CHECK(fib(10) == 55);
+    FIT_TEST_CHECK(calls == 11);
+}
+
+FIT_TEST_CASE()
+{
+    edit_distance_t ed = { "kitten sitting on the mat", "sitting kitten at the mall" };
+    std::size_t n = ed.a.size();
+    std::size_t m = ed.b.size();
+    std::vector<std::vector<int>> d(n+1, std::vector<int>(m+1));
+    for(std::size_t i=0;i<=n;i++) for(std::size_t j=0;j<=m;j++)
+    {
+        if (i == 0 || j == 0) d[i][j] = i + j;
+        else d[i][j] = std::min(d[i-1][j-1] + (ed.a[i-1] == ed.b[j-1] ? 0 : 1), std::min(d[i-1][j], d[i][j-1]) + 1);
+    }
+    FIT_TEST_CHECK(fit::memo_fix(ed)(n, m) == d[n][m]);
+    FIT_TEST_CHECK(fit::memo_fix(edit_distance_t{"kitten", "sitting"})(std::size_t(6), std::size_t(7)) == 3);
+    FIT_TEST_CHECK(fit::fix(edit_distance_t{"kitten", "sitting"})(std::size_t(6), std::size_t(7)) == 3);
+}
@@ -304,3 +304,107 @@ FIT_TEST_CASE()
 }
 
 
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(fit::pack_get<0>(fit::pack(1, 2)) == 1);
+    FIT_STATIC_TEST_CHECK(fit::pack_get<1>(fit::pack(1, 2)) == 2);
+    FIT_TEST_CHECK(fit::pack_get<1>(fit::pack(1, 2)) == 2);
+
+    FIT_STATIC_TEST_CHECK(fit::pack_get<0>(fit::pack(not_default_constructible(1), 2)).i == 1);
+    FIT_STATIC_TEST_CHECK(fit::pack_get<2>(fit::pack_decay(1, 2, 3)) == 3);
+    FIT_STATIC_TEST_CHECK(fit::pack_get<0>(fit::pack_forward(1)) == 1);
+
+    static constexpr auto p = fit::pack(1, empty1(), 3);
+    FIT_STATIC_TEST_CHECK(fit::pack_get<2>(p) == 3);
+    static_assert(std::is_same<decltype(fit::pack_get<0>(p)), const int&>::value, "Wrong const element");
+    static_assert(std::is_same<decltype(fit::pack_get<1>(p)), const empty1&>::value, "Wrong empty element");
+}
+
+FIT_TEST_CASE()
+{
+    auto p = fit::pack(1, 2);
+    fit::pack_get<0>(p) = 3;
+    FIT_TEST_CHECK(fit::pack_get<0>(p) == 3);
+    FIT_TEST_CHECK(p(binary_class()) == 5);
+    static_assert(std::is_same<decltype(fit::pack_get<0>(p)), int&>::value, "Wrong lvalue element");
+    static_assert(std::is_same<decltype(fit::pack_get<0>(fit::move(p))), int&&>::value, "Wrong rvalue element");
+
+    int x = 1;
+    auto r = fit::pack(x);
+    fit::pack_get<0>(r) = 2;
+    FIT_TEST_CHECK(x == 2);
+    static_assert(std::is_same<decltype(fit::pack_get<0>(fit::move(r))), int&>::value, "Wrong reference element");
+}
+
+FIT_TEST_CASE()
+{
+    auto p = fit::pack(std::unique_ptr<int>(new int(3)), 2);
+    FIT_TEST_CHECK(*fit::pack_get<0>(p) == 3);
+    std::unique_ptr<int> i = fit::pack_get<0>(fit::move(p));
+    FIT_TEST_CHECK(*i == 3);
+    FIT_TEST_CHECK(fit::pack_get<0>(p) == nullptr);
+    FIT_TEST_CHECK(fit::pack_get<1>(p) == 2);
+}
+
+FIT_TEST_CASE()
+{
+    static_assert(fit::pack_size<decltype(fit::pack())>::value == 0, "Wrong size");
+    static_assert(fit::pack_size<decltype(fit::pack(1, empty1(), 3))>::value == 3, "Wrong size");
+    static_assert(fit::pack_size<const decltype(fit::pack(1, 2))&>::value == 2, "Wrong size");
+    static_assert(fit::pack_size<decltype(fit::pack_join(fit::pack(1), fit::pack(2, 3)))>::value == 3, "Wrong size");
+}
+
+struct in_order
+{
+    constexpr bool operator()(char c, int i, double d) const
+    {
+        return c == 'a' && i == 1 && d == 2.5;
+    }
+};
+
+struct packed_layout
+{
+    double d;
+    int i;
+    char c1;
+    char c2;
+};
+
+FIT_TEST_CASE()
+{
+    typedef decltype(fit::pack('a', 1.5, 'b', 2)) pack_type;
+    typedef decltype(fit::pack_packed('a', 1.5, 'b', 2)) packed_type;
+    static_assert(sizeof(packed_type) == sizeof(packed_layout), "Packed pack has padding");
+    static_assert(sizeof(packed_type) < sizeof(pack_type), "Packed pack not smaller");
+    static_assert(sizeof(packed_type) <= sizeof(std::tuple<char, double, char, int>), "Packed pack larger than tuple");
+    static_assert(sizeof(decltype(fit::pack_packed(1, 2))) == sizeof(decltype(fit::pack(1, 2))), "Packed pack larger");
+    static_assert(fit::pack_size<packed_type>::value == 4, "Wrong size");
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(fit::pack_get<0>(fit::pack_packed('a', 1.5, 'b', 2)) == 'a');
+    FIT_STATIC_TEST_CHECK(fit::pack_get<1>(fit::pack_packed('a', 1.5, 'b', 2)) == 1.5);
+    FIT_STATIC_TEST_CHECK(fit::pack_get<2>(fit::pack_packed('a', 1.5, 'b', 2)) == 'b');
+    FIT_STATIC_TEST_CHECK(fit::pack_get<3>(fit::pack_packed('a', 1.5, 'b', 2)) == 2);
+    FIT_STATIC_TEST_CHECK(fit::pack_packed('a', 1, 2.5)(in_order()));
+    FIT_TEST_CHECK(fit::pack_packed('a', 1, 2.5)(in_order()));
+    FIT_STATIC_TEST_CHECK(fit::pack_packed(1, 2)(binary_class()) == 3);
+    FIT_STATIC_TEST_CHECK(fit::pack_packed()(fit::always(3)) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    char c = 'a';
+    auto p = fit::pack_packed(c, 1.5, std::unique_ptr<int>(new int(3)), empty1());
+    fit::pack_get<0>(p) = 'b';
+    FIT_TEST_CHECK(c == 'b');
+    FIT_TEST_CHECK(fit::pack_get<1>(p) == 1.5);
+    static_assert(std::is_same<decltype(fit::pack_get<0>(fit::move(p))), char&>::value, "Wrong reference element");
+    static_assert(std::is_same<decltype(fit::pack_get<1>(fit::move(p))), double&&>::value, "Wrong rvalue element");
+    static_assert(std::is_same<decltype(fit::pack_get<1>(static_cast<const decltype(p)&>(p))), const double&>::value, "Wrong const element");
+    std::unique_ptr<int> i = fit::pack_get<2>(fit::move(p));
+    FIT_TEST_CHECK(*i == 3);
+    FIT_TEST_CHECK(fit::pack_get<2>(p) == nullptr);
+}
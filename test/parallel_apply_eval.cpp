@@ -0,0 +1,171 @@
+#include <fit/parallel_apply_eval.h>
+#include "test.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+struct sum_f
+{
+    template<class... Ts>
+    int operator()(Ts... xs) const
+    {
+        int result = 0;
+        for(int x:{0, xs...}) result += x;
+        return result;
+    }
+};
+
+struct deref_sum
+{
+    int operator()(std::unique_ptr<int> x, const int& y) const
+    {
+        return *x + y;
+    }
+};
+
+template<int N>
+struct constant
+{
+    int operator()() const
+    {
+        return N;
+    }
+};
+
+// Drops every task, so the calling thread has to evaluate everything
+struct drop_executor
+{
+    int submitted = 0;
+    template<class F>
+    void execute(F)
+    {
+        submitted++;
+    }
+};
+
+// Holds on to every task, so they can be run after the call has returned
+struct deferred_executor
+{
+    std::vector<std::function<void()>> tasks;
+    template<class F>
+    void execute(F f)
+    {
+        tasks.push_back(f);
+    }
+};
+
+struct throwing_executor
+{
+    template<class F>
+    void execute(F)
+    {
+        throw std::runtime_error("Executor failed");
+    }
+};
+
+// Returns true if all N thunks are running at the same time
+template<int N>
+struct rendezvous
+{
+    std::atomic<int>& arrived;
+    int operator()() const
+    {
+        arrived++;
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while(arrived.load() < N && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        return arrived.load() >= N ? 1 : 0;
+    }
+};
+
+template<int N>
+struct throw_after
+{
+    int delay;
+    int operator()() const
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+        throw std::runtime_error(std::to_string(N));
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::parallel_apply_eval(sum_f()) == 0);
+    FIT_TEST_CHECK(fit::parallel_apply_eval(sum_f(), constant<1>()) == 1);
+    FIT_TEST_CHECK(fit::parallel_apply_eval(sum_f(), constant<1>(), constant<2>(), constant<3>()) == 6);
+    int x = 2;
+    FIT_TEST_CHECK(fit::parallel_apply_eval(deref_sum(), 
+        [] { return std::unique_ptr<int>(new int(1)); }, 
+        [&]() -> const int& { return x; }
+    ) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    fit::thread_pool pool(3);
+    std::atomic<int> arrived(0);
+    rendezvous<3> r = {arrived};
+    FIT_TEST_CHECK(fit::parallel_apply_eval_with(pool, sum_f(), r, r, r) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    drop_executor e;
+    FIT_TEST_CHECK(fit::parallel_apply_eval_with(e, sum_f(), constant<1>(), constant<2>(), constant<3>()) == 6);
+    FIT_TEST_CHECK(e.submitted == 2);
+    throwing_executor te;
+    FIT_TEST_CHECK(fit::parallel_apply_eval_with(te, sum_f(), constant<1>(), constant<2>()) == 3);
+}
+
+struct counted
+{
+    int& count;
+    int operator()() const
+    {
+        count++;
+        return 1;
+    }
+};
+
+// Tasks that run after the call returned don't evaluate their arguments again
+FIT_TEST_CASE()
+{
+    deferred_executor e;
+    int count = 0;
+    FIT_TEST_CHECK(fit::parallel_apply_eval_with(e, sum_f(), counted{count}, counted{count}, counted{count}) == 3);
+    FIT_TEST_CHECK(count == 3);
+    FIT_TEST_CHECK(e.tasks.size() == 2);
+    for(auto& t:e.tasks) t();
+    FIT_TEST_CHECK(count == 3);
+}
+
+FIT_TEST_CASE()
+{
+    fit::thread_pool pool(3);
+    for(int i=0;i<5;i++)
+    {
+        std::string what;
+        try
+        {
+            fit::parallel_apply_eval_with(pool, sum_f(), constant<1>(), throw_after<1>{20}, throw_after<2>{0});
+        }
+        catch(const std::runtime_error& e)
+        {
+            what = e.what();
+        }
+        FIT_TEST_CHECK(what == "1");
+    }
+}
+
+FIT_TEST_CASE()
+{
+    // Nested calls from a worker thread don't deadlock
+    fit::thread_pool pool(1);
+    auto inner = [&] { return fit::parallel_apply_eval_with(pool, sum_f(), constant<1>(), constant<2>()); };
+    FIT_TEST_CHECK(fit::parallel_apply_eval_with(pool, sum_f(), inner, inner, inner) == 9);
+}
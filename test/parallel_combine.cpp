@@ -0,0 +1,107 @@
+#include <fit/parallel_combine.h>
+#include <fit/placeholders.h>
+#include "test.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct sum_f
+{
+    template<class T>
+    int operator()(const std::vector<T>& v) const
+    {
+        return std::accumulate(v.begin(), v.end(), 0);
+    }
+};
+
+struct thread_id_f
+{
+    template<class T>
+    std::thread::id operator()(const T&) const
+    {
+        return std::this_thread::get_id();
+    }
+};
+
+struct large
+{
+    std::size_t size() const
+    {
+        return FIT_PARALLEL_COMBINE_THRESHOLD;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto f = fit::parallel_combine(fit::_ + fit::_, sum_f(), sum_f());
+    FIT_TEST_CHECK(f(std::vector<int>(10000, 1), std::vector<int>(10000, 2)) == 30000);
+    FIT_TEST_CHECK(f(std::vector<int>{1, 2}, std::vector<int>{3}) == 6);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::parallel_cost<int>::apply(3) == 1);
+    FIT_TEST_CHECK(fit::parallel_cost<std::string>::apply("abc") == 3);
+    FIT_TEST_CHECK(fit::parallel_cost<std::vector<int>>::apply(std::vector<int>(5)) == 5);
+}
+
+// Small inputs are called inline on the calling thread
+FIT_TEST_CASE()
+{
+    auto id = std::this_thread::get_id();
+    auto f = fit::parallel_combine(fit::_ == fit::_, thread_id_f(), thread_id_f());
+    FIT_TEST_CHECK(f(1, 2));
+    auto g = fit::parallel_combine(fit::identity, thread_id_f());
+    FIT_TEST_CHECK(g(large()) == id);
+}
+
+// Large inputs are called concurrently, so each function can wait for the other
+FIT_TEST_CASE()
+{
+    std::mutex m;
+    std::condition_variable cv;
+    int arrived = 0;
+    auto rendezvous = [&](const large&)
+    {
+        std::unique_lock<std::mutex> lock(m);
+        arrived++;
+        cv.notify_all();
+        cv.wait(lock, [&] { return arrived == 2; });
+        return std::this_thread::get_id();
+    };
+    auto f = fit::parallel_combine(fit::_ != fit::_, rendezvous, rendezvous);
+    FIT_TEST_CHECK(f(large(), large()));
+    FIT_TEST_CHECK(arrived == 2);
+}
+
+FIT_TEST_CASE()
+{
+    auto throws = [](const large&) -> int { throw std::runtime_error("error"); };
+    auto f = fit::parallel_combine(fit::_ + fit::_, sum_f(), throws);
+    bool caught = false;
+    try
+    {
+        f(std::vector<int>(10000, 1), large());
+    }
+    catch(const std::runtime_error&)
+    {
+        caught = true;
+    }
+    FIT_TEST_CHECK(caught);
+}
+
+// Nested calls from the pool's own threads don't deadlock
+FIT_TEST_CASE()
+{
+    auto inner = fit::parallel_combine(fit::_ + fit::_, sum_f(), sum_f());
+    auto outer_g = [&](const std::vector<int>& v) { return inner(v, v); };
+    auto outer = fit::parallel_combine(fit::_ + fit::_, outer_g, outer_g);
+    std::vector<int> v(10000, 1);
+    FIT_TEST_CHECK(outer(v, v) == 40000);
+}
@@ -0,0 +1,87 @@
+#include <fit/permute.h>
+#include <fit/flip.h>
+#include <fit/rotate.h>
+#include <fit/is_callable.h>
+#include <fit/placeholders.h>
+#include "test.h"
+
+#include <memory>
+
+struct triple_class
+{
+    template<class T, class U, class V>
+    constexpr int operator()(T x, U y, V z) const
+    {
+        return 100*x + 10*y + z;
+    }
+};
+
+struct move_arg_class
+{
+    int operator()(std::unique_ptr<int> x, int y) const
+    {
+        return *x + y;
+    }
+};
+
+struct ref_class
+{
+    void operator()(int& x, int& y) const
+    {
+        x++;
+        y++;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(3 == fit::permute<1, 0>(fit::_ - fit::_)(2, 5));
+    FIT_STATIC_TEST_CHECK(3 == fit::permute<1, 0>(fit::_ - fit::_)(2, 5));
+    FIT_TEST_CHECK(312 == fit::permute<2, 0, 1>(triple_class())(1, 2, 3));
+    FIT_STATIC_TEST_CHECK(312 == fit::permute<2, 0, 1>(triple_class())(1, 2, 3));
+    FIT_TEST_CHECK(123 == fit::permute<0, 1, 2>(triple_class())(1, 2, 3));
+}
+
+// The same as nesting flip and rotate
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::flip(fit::rotate(fit::rotate(triple_class())))(1, 2, 3) == fit::permute<1, 0, 2>(triple_class())(2, 3, 1));
+    FIT_TEST_CHECK(fit::rotate(triple_class())(1, 2, 3) == fit::permute<1, 2, 0>(triple_class())(1, 2, 3));
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(4 == fit::permute<1, 0>(move_arg_class())(3, std::unique_ptr<int>(new int(1))));
+    FIT_TEST_CHECK(3 == fit::permute<1, 0>(binary_class())(1, 2));
+    STATIC_ASSERT_EMPTY((fit::permute<1, 0>(binary_class())));
+}
+
+FIT_TEST_CASE()
+{
+    static_assert(fit::is_callable<fit::permute_adaptor<binary_class, 1, 0>, int, int>::value, "Not callable");
+    static_assert(!fit::is_callable<fit::permute_adaptor<binary_class, 1, 0>, int>::value, "Callable");
+    static_assert(!fit::is_callable<fit::permute_adaptor<binary_class, 1, 0>, int, int, int>::value, "Callable");
+    static_assert(!fit::is_callable<fit::permute_adaptor<triple_class, 1, 0, 2>, int, int>::value, "Callable");
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(25 == fit::select<1, 1>(fit::_ * fit::_)(2, 5));
+    FIT_STATIC_TEST_CHECK(25 == fit::select<1, 1>(fit::_ * fit::_)(2, 5));
+    FIT_TEST_CHECK(2 == fit::select<2, 0>(fit::_ - fit::_)(1, 2, 3));
+    FIT_STATIC_TEST_CHECK(2 == fit::select<2, 0>(fit::_ - fit::_)(1, 2, 3));
+    FIT_TEST_CHECK(331 == fit::select<2, 2, 0>(triple_class())(1, 2, 3));
+    FIT_TEST_CHECK(2 == fit::select<1>(unary_class())(1, 2, 3));
+    FIT_TEST_CHECK(4 == fit::select<1, 0>(move_arg_class())(3, std::unique_ptr<int>(new int(1))));
+}
+
+// Repeated parameters are passed as lvalues
+FIT_TEST_CASE()
+{
+    int i = 0;
+    fit::select<0, 0>(ref_class())(i);
+    FIT_TEST_CHECK(i == 2);
+    static_assert(!fit::is_callable<fit::select_adaptor<move_arg_class, 0, 0>, std::unique_ptr<int>>::value, "Callable");
+    static_assert(fit::is_callable<fit::select_adaptor<binary_class, 0, 0>, int>::value, "Not callable");
+    static_assert(!fit::is_callable<fit::select_adaptor<binary_class, 0, 2>, int, int>::value, "Callable");
+}
@@ -1,6 +1,7 @@
 #include <fit/pipable.h>
 #include <fit/static.h>
 #include "test.h"
+#include <memory>
 
 fit::static_<fit::pipable_adaptor<binary_class> > binary_pipable = {};
 
@@ -61,3 +62,70 @@ FIT_TEST_CASE()
     FIT_STATIC_TEST_CHECK(3 == (unary_pipable_constexpr(3)));
 }
 
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(7 == (1 | fit::pipe_chain(binary_pipable(2), binary_pipable(4))));
+    FIT_TEST_CHECK(10 == (1 | fit::pipe_chain(binary_pipable(2), binary_pipable(3), binary_pipable(4))));
+    FIT_TEST_CHECK(10 == (1 | binary_pipable(2) | binary_pipable(3) | binary_pipable(4)));
+    FIT_TEST_CHECK(3 == (1 | fit::pipe_chain(fit::pipable(move_class())(1), fit::pipable(move_class())(1))));
+    FIT_TEST_CHECK(5 == fit::pipe_chain(binary_pipable(2), binary_pipable(2))(1));
+    int i = 1;
+    FIT_TEST_CHECK(3 == (i | fit::pipe_chain(mutable_pipable(1), binary_pipable(1))));
+    FIT_TEST_CHECK(2 == i);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(7 == (1 | fit::pipe_chain(binary_pipable_constexpr(2), binary_pipable_constexpr(4))));
+    FIT_STATIC_TEST_CHECK(10 == (1 | fit::pipe_chain(binary_pipable_constexpr(2), binary_pipable_constexpr(3), binary_pipable_constexpr(4))));
+}
+
+// A chain holds copies of its stages and their arguments, so it can be
+// stored and used after the temporaries it was built from are gone
+FIT_TEST_CASE()
+{
+    auto chain = fit::pipe_chain(binary_pipable(2), binary_pipable(3), binary_pipable(4), binary_pipable(5));
+    FIT_TEST_CHECK(15 == (1 | chain));
+    FIT_TEST_CHECK(16 == (2 | chain));
+    auto longer = fit::pipe_chain(chain, binary_pipable(6));
+    FIT_TEST_CHECK(21 == (1 | longer));
+    FIT_TEST_CHECK(15 == (1 | chain));
+
+    int i = 2;
+    auto stored = fit::pipe_chain(binary_pipable(i), binary_pipable(i));
+    i = 10;
+    FIT_TEST_CHECK(5 == (1 | stored));
+}
+
+struct add_ptr
+{
+    int operator()(int x, const std::unique_ptr<int>& p) const
+    {
+        return x + *p;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto chain = fit::pipe_chain(fit::pipable(add_ptr())(std::unique_ptr<int>(new int(2))), fit::pipable(move_class())(3));
+    FIT_TEST_CHECK(6 == (1 | chain));
+    FIT_TEST_CHECK(6 == (1 | fit::pipe_chain(fit::pipable(add_ptr())(std::unique_ptr<int>(new int(2))), binary_pipable(3))));
+}
+
+struct apply_to
+{
+    template<class F>
+    int operator()(F f, int x) const
+    {
+        return f(x);
+    }
+};
+
+// Piping a partially applied function into another passes it as the first
+// argument, like any other value
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(3 == (binary_pipable(2) | fit::pipable(apply_to())(1)));
+    FIT_TEST_CHECK(4 == (fit::pipe_chain(binary_pipable(1), binary_pipable(2)) | fit::pipable(apply_to())(1)));
+}
@@ -0,0 +1,275 @@
+#include <fit/pipeline.h>
+#include "test.h"
+
+#if defined(__linux__) && !defined(__SANITIZE_ADDRESS__) && !defined(__SANITIZE_THREAD__)
+#include <sys/resource.h>
+#include <fstream>
+#include <system_error>
+#define FIT_TEST_THREAD_FAILURE 1
+#else
+#define FIT_TEST_THREAD_FAILURE 0
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct increment
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x + 1;
+    }
+};
+
+struct twice
+{
+    template<class T>
+    constexpr T operator()(T x) const
+    {
+        return x * 2;
+    }
+};
+
+struct to_string_f
+{
+    std::string operator()(int x) const
+    {
+        return std::to_string(x);
+    }
+};
+
+struct thread_ids
+{
+    std::mutex* m;
+    std::set<std::thread::id>* ids;
+
+    template<class T>
+    T operator()(T x) const
+    {
+        std::lock_guard<std::mutex> lock(*m);
+        ids->insert(std::this_thread::get_id());
+        return x;
+    }
+};
+
+struct throw_at
+{
+    int n;
+
+    int operator()(int x) const
+    {
+        if (x == n) throw std::runtime_error("error");
+        return x;
+    }
+};
+
+struct move_only_f
+{
+    std::unique_ptr<int> operator()(int x) const
+    {
+        return std::unique_ptr<int>(new int(x));
+    }
+};
+
+struct deref_f
+{
+    int operator()(std::unique_ptr<int> p) const
+    {
+        return *p;
+    }
+};
+
+// Reads n values, but only reads the next one after the previous one has
+// reached the output, so it can only finish if every value is passed on
+// right away rather than held back until a batch is full
+struct lockstep_iterator
+{
+    typedef std::input_iterator_tag iterator_category;
+    typedef int value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const int* pointer;
+    typedef const int& reference;
+
+    int i;
+    const std::atomic<int>* received;
+    bool* timed_out;
+
+    const int& operator*() const
+    {
+        return i;
+    }
+
+    lockstep_iterator& operator++()
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while(received->load() <= i && std::chrono::steady_clock::now() < deadline) std::this_thread::yield();
+        if (received->load() <= i) *timed_out = true;
+        i++;
+        return *this;
+    }
+
+    bool operator==(const lockstep_iterator& rhs) const
+    {
+        return i == rhs.i;
+    }
+
+    bool operator!=(const lockstep_iterator& rhs) const
+    {
+        return i != rhs.i;
+    }
+};
+
+struct count_output
+{
+    std::atomic<int>* received;
+
+    template<class T>
+    T operator()(T x) const
+    {
+        (*received)++;
+        return x;
+    }
+};
+
+#if FIT_TEST_THREAD_FAILURE
+// Limits the address space so that only one more thread stack fits, so the
+// first stage starts but the thread for the second stage can't be created.
+// The first stage must not be left waiting on a queue nothing reads from.
+// This runs before any other test, since finished threads leave their
+// stacks cached for reuse.
+FIT_TEST_CASE()
+{
+    rlimit stack;
+    rlimit old;
+    getrlimit(RLIMIT_STACK, &stack);
+    getrlimit(RLIMIT_AS, &old);
+    if (stack.rlim_cur == RLIM_INFINITY) return;
+    std::size_t pages = 0;
+    std::ifstream("/proc/self/statm") >> pages;
+    std::vector<int> in(100000, 1);
+    std::vector<int> out;
+    out.reserve(in.size());
+    rlimit limit = old;
+    limit.rlim_cur = pages * 4096 + stack.rlim_cur + stack.rlim_cur / 2;
+    if (old.rlim_cur != RLIM_INFINITY && old.rlim_cur < limit.rlim_cur) return;
+    setrlimit(RLIMIT_AS, &limit);
+    bool caught = false;
+    try
+    {
+        fit::pipeline(increment(), increment(), increment()).run(in.begin(), in.end(), std::back_inserter(out));
+    }
+    catch(const std::system_error&)
+    {
+        caught = true;
+    }
+    setrlimit(RLIMIT_AS, &old);
+    FIT_TEST_CHECK(caught);
+}
+#endif
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::pipeline(increment(), twice())(3) == 8);
+    FIT_STATIC_TEST_CHECK(fit::pipeline(increment(), twice(), increment())(3) == 9);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> in;
+    for(int i=0;i<10000;i++) in.push_back(i);
+    std::vector<std::string> out;
+    fit::pipeline(increment(), twice(), to_string_f()).run(in.begin(), in.end(), std::back_inserter(out));
+    FIT_TEST_CHECK(out.size() == in.size());
+    bool same = true;
+    for(int i=0;i<10000;i++) same = same && out[i] == std::to_string((i + 1) * 2);
+    FIT_TEST_CHECK(same);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> in = {1, 2, 3};
+    std::vector<int> out;
+    fit::pipeline(increment()).run(in.begin(), in.end(), std::back_inserter(out));
+    FIT_TEST_CHECK(out == std::vector<int>({2, 3, 4}));
+    std::vector<int> empty;
+    fit::pipeline(increment(), twice()).run(empty.begin(), empty.end(), std::back_inserter(out));
+    FIT_TEST_CHECK(out.size() == 3);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> in = {1, 2, 3};
+    std::vector<int> out;
+    fit::pipeline(move_only_f(), deref_f()).run(in.begin(), in.end(), std::back_inserter(out));
+    FIT_TEST_CHECK(out == in);
+}
+
+FIT_TEST_CASE()
+{
+    std::mutex m;
+    std::set<std::thread::id> first, last;
+    std::vector<int> in(100, 1);
+    std::vector<int> out;
+    fit::pipeline(thread_ids{&m, &first}, increment(), thread_ids{&m, &last})
+        .run(in.begin(), in.end(), std::back_inserter(out));
+    FIT_TEST_CHECK(first.size() == 1);
+    FIT_TEST_CHECK(last.size() == 1);
+    FIT_TEST_CHECK(*first.begin() != *last.begin());
+    FIT_TEST_CHECK(*last.begin() == std::this_thread::get_id());
+}
+
+// The exception from the earliest stage is rethrown, even when the input is
+// much larger than the queues
+FIT_TEST_CASE()
+{
+    std::vector<int> in;
+    for(int i=0;i<100000;i++) in.push_back(i);
+    for(int n:{0, 10, 5000})
+    {
+        std::vector<int> out;
+        std::string message;
+        try
+        {
+            fit::pipeline(throw_at{n}, increment(), throw_at{n+1}).run(in.begin(), in.end(), std::back_inserter(out));
+        }
+        catch(const std::runtime_error& e)
+        {
+            message = e.what();
+        }
+        FIT_TEST_CHECK(message == "error");
+        FIT_TEST_CHECK(out.size() <= std::size_t(n));
+    }
+    std::vector<int> out;
+    bool caught = false;
+    try
+    {
+        fit::pipeline(increment(), increment(), throw_at{50000}).run(in.begin(), in.end(), std::back_inserter(out));
+    }
+    catch(const std::runtime_error&)
+    {
+        caught = true;
+    }
+    FIT_TEST_CHECK(caught);
+}
+
+FIT_TEST_CASE()
+{
+    std::atomic<int> received(0);
+    bool timed_out = false;
+    lockstep_iterator first = {0, &received, &timed_out};
+    lockstep_iterator last = {5, &received, &timed_out};
+    std::vector<int> out;
+    fit::pipeline(increment(), twice(), count_output{&received}).run(first, last, std::back_inserter(out));
+    FIT_TEST_CHECK(!timed_out);
+    FIT_TEST_CHECK(out == std::vector<int>({2, 4, 6, 8, 10}));
+}
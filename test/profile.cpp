@@ -0,0 +1,99 @@
+#include <fit/profile.h>
+#include "test.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static fit::profile_stats find_stats(const std::string& name)
+{
+    for(const fit::profile_stats& s:fit::profile_report())
+    {
+        if (s.name == name) return s;
+    }
+    return fit::profile_stats{};
+}
+
+static std::uint64_t histogram_total(const fit::profile_stats& s)
+{
+    std::uint64_t n = 0;
+    for(std::uint64_t h:s.histogram) n += h;
+    return n;
+}
+
+struct throws_f
+{
+    void operator()() const
+    {
+        throw std::runtime_error("error");
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto f = fit::profile("binary", binary_class());
+    FIT_TEST_CHECK(f(1, 2) == 3);
+    FIT_TEST_CHECK(f(3, 4) == 7);
+    fit::profile_stats s = find_stats("binary");
+    FIT_TEST_CHECK(s.name == "binary");
+    FIT_TEST_CHECK(s.count == 2);
+    FIT_TEST_CHECK(s.max_ns <= s.total_ns);
+    FIT_TEST_CHECK(histogram_total(s) == 2);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::profile("move", move_class());
+    FIT_TEST_CHECK(f(1, 2) == 3);
+    auto g = fit::profile("void", void_class());
+    g(1);
+    FIT_TEST_CHECK(find_stats("void").count == 1);
+}
+
+// Functions with the same name are recorded together
+FIT_TEST_CASE()
+{
+    auto f = fit::profile("shared", binary_class());
+    auto g = fit::profile("shared", unary_class());
+    f(1, 2);
+    g(1);
+    FIT_TEST_CHECK(find_stats("shared").count == 2);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::profile("throws", throws_f());
+    bool caught = false;
+    try { f(); }
+    catch(const std::runtime_error&) { caught = true; }
+    FIT_TEST_CHECK(caught);
+    FIT_TEST_CHECK(find_stats("throws").count == 1);
+}
+
+// Counters from each thread are added together
+FIT_TEST_CASE()
+{
+    auto f = fit::profile("threads", unary_class());
+    std::vector<std::thread> threads;
+    for(int i=0;i<4;i++) threads.emplace_back([&] { for(int j=0;j<100;j++) f(j); });
+    for(std::thread& t:threads) t.join();
+    fit::profile_stats s = find_stats("threads");
+    FIT_TEST_CHECK(s.count == 400);
+    FIT_TEST_CHECK(histogram_total(s) == 400);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::profile("dump \"quoted\"", unary_class());
+    f(1);
+    std::stringstream text;
+    fit::profile_dump_text(text);
+    FIT_TEST_CHECK(text.str().find("dump \"quoted\": count=1 ") != std::string::npos);
+    std::stringstream json;
+    fit::profile_dump_json(json);
+    FIT_TEST_CHECK(json.str().front() == '[');
+    FIT_TEST_CHECK(json.str().back() == ']');
+    FIT_TEST_CHECK(json.str().find("{\"name\":\"dump \\\"quoted\\\"\",\"count\":1,") != std::string::npos);
+}
@@ -0,0 +1,25 @@
+#define FIT_PROFILE 0
+#include <fit/profile.h>
+#include "test.h"
+
+#include <sstream>
+
+// When profiling is turned off, profile returns the function unchanged
+FIT_TEST_CASE()
+{
+    STATIC_ASSERT_SAME(decltype(fit::profile("binary", binary_class())), binary_class);
+    STATIC_ASSERT_EMPTY(fit::profile("binary", binary_class()));
+    FIT_STATIC_TEST_CHECK(fit::profile("binary", binary_class())(1, 2) == 3);
+    FIT_TEST_CHECK(fit::profile("binary", binary_class())(1, 2) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::profile_report().empty());
+    std::stringstream text;
+    fit::profile_dump_text(text);
+    FIT_TEST_CHECK(text.str().empty());
+    std::stringstream json;
+    fit::profile_dump_json(json);
+    FIT_TEST_CHECK(json.str() == "[]");
+}
@@ -0,0 +1,104 @@
+#include <fit/range.h>
+#include <fit/placeholders.h>
+#include "test.h"
+
+#include <list>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct counted_square
+{
+    int* calls;
+
+    int operator()(int x) const
+    {
+        ++*calls;
+        return x * x;
+    }
+};
+
+struct is_even
+{
+    bool operator()(int x) const
+    {
+        return x % 2 == 0;
+    }
+};
+
+struct concat_f
+{
+    std::string operator()(std::string s, const std::string& x) const
+    {
+        return s + x;
+    }
+};
+
+struct sum_ptr_f
+{
+    int operator()(int r, const std::unique_ptr<int>& p) const
+    {
+        return r + *p;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v = {1, 2, 3, 4, 5, 6};
+    int r = v
+        | fit::filter(is_even())
+        | fit::transform(fit::_1 * fit::_1)
+        | fit::take(2)
+        | fit::fold(fit::_1 + fit::_2, 0);
+    FIT_TEST_CHECK(r == 4 + 16);
+    FIT_TEST_CHECK((v | fit::fold(fit::_1 + fit::_2, 0)) == 21);
+    FIT_TEST_CHECK((v | fit::transform(fit::_1 + 1) | fit::fold(fit::_1 + fit::_2, 0)) == 27);
+}
+
+// The loop stops once take has seen enough values
+FIT_TEST_CASE()
+{
+    std::vector<int> v(1000, 2);
+    int calls = 0;
+    int r = v
+        | fit::transform(counted_square{&calls})
+        | fit::take(3)
+        | fit::fold(fit::_1 + fit::_2, 0);
+    FIT_TEST_CHECK(r == 12);
+    FIT_TEST_CHECK(calls == 3);
+    FIT_TEST_CHECK((v | fit::take(0) | fit::fold(fit::_1 + fit::_2, 0)) == 0);
+}
+
+// Stages can be composed without a range and reused
+FIT_TEST_CASE()
+{
+    auto evens_squared = fit::filter(is_even()) | fit::transform(fit::_1 * fit::_1);
+    std::vector<int> v = {1, 2, 3, 4};
+    std::list<int> l = {6, 7};
+    FIT_TEST_CHECK((v | evens_squared | fit::fold(fit::_1 + fit::_2, 0)) == 20);
+    FIT_TEST_CHECK((l | evens_squared | fit::fold(fit::_1 + fit::_2, 0)) == 36);
+    auto first_two = fit::take(2) | fit::take(5);
+    FIT_TEST_CHECK((v | first_two | fit::fold(fit::_1 + fit::_2, 0)) == 3);
+    FIT_TEST_CHECK((v | first_two | fit::fold(fit::_1 + fit::_2, 0)) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    int a[] = {1, 2, 3};
+    FIT_TEST_CHECK((a | fit::transform(fit::_1 * 2) | fit::fold(fit::_1 + fit::_2, 0)) == 12);
+    std::vector<std::string> s = {"a", "bb", "ccc"};
+    std::string r = s
+        | fit::filter([](const std::string& x) { return x.size() > 1; })
+        | fit::fold(concat_f(), std::string());
+    FIT_TEST_CHECK(r == "bbccc");
+}
+
+// Rvalue ranges are moved into the pipeline, and values are forwarded
+FIT_TEST_CASE()
+{
+    std::vector<std::unique_ptr<int>> v;
+    v.emplace_back(new int(1));
+    v.emplace_back(new int(2));
+    FIT_TEST_CHECK((std::move(v) | fit::take(5) | fit::fold(sum_ptr_f(), 0)) == 3);
+    FIT_TEST_CHECK((std::vector<int>{1, 2, 3} | fit::take(2) | fit::fold(fit::_1 + fit::_2, 0)) == 3);
+}
@@ -0,0 +1,131 @@
+#include <fit/reduce.h>
+#include <fit/placeholders.h>
+#include "test.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+struct sum_f
+{
+    template<class T, class U>
+    T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+struct max_f
+{
+    int operator()(int x, int y) const
+    {
+        return std::max(x, y);
+    }
+};
+
+struct string_length
+{
+    std::size_t operator()(const std::string& s) const
+    {
+        return s.size();
+    }
+};
+
+struct throws_at
+{
+    int n;
+    int operator()(int x, int y) const
+    {
+        if (y == n) throw std::runtime_error("error");
+        return x + y;
+    }
+};
+
+// Has no size, and runs every task as soon as it's submitted
+struct inline_executor
+{
+    int submitted = 0;
+    template<class F>
+    void execute(F f)
+    {
+        submitted++;
+        f();
+    }
+};
+
+static std::vector<long long> iota(int n)
+{
+    std::vector<long long> v(n);
+    std::iota(v.begin(), v.end(), 0);
+    return v;
+}
+
+FIT_TEST_CASE()
+{
+    for(int n:{0, 1, 2, 100, 4096, 4097, 100000})
+    {
+        std::vector<long long> v = iota(n);
+        long long expected = (long long)n * (n - 1) / 2;
+        FIT_TEST_CHECK(fit::reduce(v, fit::compress(sum_f(), 0LL)) == expected);
+        FIT_TEST_CHECK(fit::reduce(v, fit::compress(sum_f(), 0LL), fit::reduce_order::deterministic) == expected);
+        FIT_TEST_CHECK(fit::reduce(v, fit::compress(sum_f(), 10LL)) == expected + 10);
+        FIT_TEST_CHECK(fit::reduce(v, fit::compress(sum_f())) == expected);
+    }
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v;
+    for(int i=0;i<50000;i++) v.push_back((i * 7919) % 50000);
+    FIT_TEST_CHECK(fit::reduce(v, fit::compress(max_f(), -1)) == 49999);
+    FIT_TEST_CHECK(fit::reduce(std::vector<int>(), fit::compress(max_f(), -1)) == -1);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<std::string> v(20000, "abc");
+    v.push_back("abcdef");
+    FIT_TEST_CHECK(fit::transform_reduce(v, fit::by(string_length(), sum_f())) == 60006);
+    FIT_TEST_CHECK(fit::transform_reduce(v, fit::by(string_length(), sum_f()), fit::reduce_order::deterministic) == 60006);
+    FIT_TEST_CHECK(fit::transform_reduce(std::vector<std::string>(), fit::by(string_length(), sum_f())) == 0);
+    std::vector<long long> w = iota(10000);
+    FIT_TEST_CHECK(fit::transform_reduce(w, fit::by(fit::_1 * fit::_1, fit::_ + fit::_)) == 333283335000LL);
+}
+
+// The deterministic order gives the same result on any executor
+FIT_TEST_CASE()
+{
+    std::vector<double> v;
+    for(int i=0;i<100000;i++) v.push_back(1.0 / (i + 1));
+    fit::work_stealing_pool one(1);
+    fit::work_stealing_pool four(4);
+    double a = fit::reduce_with(one, v, fit::compress(sum_f(), 0.0), fit::reduce_order::deterministic);
+    double b = fit::reduce_with(four, v, fit::compress(sum_f(), 0.0), fit::reduce_order::deterministic);
+    double c = fit::reduce(v, fit::compress(sum_f(), 0.0), fit::reduce_order::deterministic);
+    FIT_TEST_CHECK(a == b);
+    FIT_TEST_CHECK(a == c);
+    double d = fit::transform_reduce_with(four, v, fit::by(fit::_1 * fit::_1, sum_f()), fit::reduce_order::deterministic);
+    double e = fit::transform_reduce_with(one, v, fit::by(fit::_1 * fit::_1, sum_f()), fit::reduce_order::deterministic);
+    FIT_TEST_CHECK(d == e);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v(100000, 1);
+    v[70000] = 2;
+    bool caught = false;
+    try { fit::reduce(v, fit::compress(throws_at{2}, 0)); }
+    catch(const std::runtime_error&) { caught = true; }
+    FIT_TEST_CHECK(caught);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<long long> v = iota(100000);
+    inline_executor e;
+    FIT_TEST_CHECK(fit::reduce_with(e, v, fit::compress(sum_f(), 0LL)) == 4999950000LL);
+    FIT_TEST_CHECK(fit::transform_reduce_with(e, v, fit::by(fit::_1 + 1, sum_f())) == 5000050000LL);
+    FIT_TEST_CHECK(e.submitted > 0);
+}
@@ -0,0 +1,148 @@
+#include <fit/sort_by.h>
+#include "test.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+struct item
+{
+    int key;
+    int order;
+};
+
+struct item_key
+{
+    int operator()(const item& x) const
+    {
+        return x.key;
+    }
+};
+
+struct counted_key
+{
+    int& calls;
+    int operator()(const item& x) const
+    {
+        calls++;
+        return x.key;
+    }
+};
+
+struct string_length
+{
+    std::size_t operator()(const std::string& s) const
+    {
+        return s.size();
+    }
+};
+
+struct identity_key
+{
+    template<class T>
+    T operator()(T x) const
+    {
+        return x;
+    }
+};
+
+struct ptr_key
+{
+    int operator()(const std::unique_ptr<int>& p) const
+    {
+        return *p;
+    }
+};
+
+static std::vector<item> make_items(int n, int range)
+{
+    std::mt19937 gen(n);
+    std::uniform_int_distribution<int> dist(-range, range);
+    std::vector<item> v;
+    for(int i=0;i<n;i++) v.push_back(item{dist(gen), i});
+    return v;
+}
+
+static bool is_stably_sorted(const std::vector<item>& v)
+{
+    for(std::size_t i = 1; i < v.size(); i++)
+    {
+        if (v[i-1].key > v[i].key) return false;
+        if (v[i-1].key == v[i].key && v[i-1].order > v[i].order) return false;
+    }
+    return true;
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<std::string> v = {"ccc", "a", "bb", "dddd", ""};
+    fit::sort_by(v, string_length());
+    FIT_TEST_CHECK(v == (std::vector<std::string>{"", "a", "bb", "ccc", "dddd"}));
+    fit::sort_by(v, string_length(), std::greater<std::size_t>());
+    FIT_TEST_CHECK(v == (std::vector<std::string>{"dddd", "ccc", "bb", "a", ""}));
+    fit::sort_by(v, fit::by(string_length(), std::less<std::size_t>()));
+    FIT_TEST_CHECK(v.front() == "" && v.back() == "dddd");
+}
+
+// The projection is called once for each element
+FIT_TEST_CASE()
+{
+    std::vector<item> v = make_items(1000, 50);
+    int calls = 0;
+    fit::sort_by(v, counted_key{calls});
+    FIT_TEST_CHECK(calls == 1000);
+    FIT_TEST_CHECK(std::is_sorted(v.begin(), v.end(), fit::by(item_key(), std::less<int>())));
+}
+
+// Small ranges are sorted by comparison, and large ones by a radix sort
+FIT_TEST_CASE()
+{
+    for(int n:{0, 1, 2, 10, 255, 256, 5000})
+    {
+        std::vector<item> v = make_items(n, 20);
+        fit::stable_sort_by(v, item_key());
+        FIT_TEST_CHECK(is_stably_sorted(v));
+        std::vector<item> w = make_items(n, 1000000);
+        fit::sort_by(w, item_key());
+        FIT_TEST_CHECK(std::is_sorted(w.begin(), w.end(), fit::by(item_key(), std::less<int>())));
+    }
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<item> v = make_items(2000, 100);
+    fit::stable_sort_by(v, item_key(), std::greater<int>());
+    for(std::size_t i = 1; i < v.size(); i++)
+    {
+        FIT_TEST_CHECK(v[i-1].key >= v[i].key);
+        if (v[i-1].key == v[i].key) FIT_TEST_CHECK(v[i-1].order < v[i].order);
+    }
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<std::int64_t> v = {INT64_MAX, -1, 0, INT64_MIN, 1, -300, 300};
+    v.resize(1000, 7);
+    std::vector<std::int64_t> expected = v;
+    std::sort(expected.begin(), expected.end());
+    fit::sort_by(v, identity_key());
+    FIT_TEST_CHECK(v == expected);
+    std::vector<unsigned char> u;
+    for(int i=0;i<1000;i++) u.push_back((unsigned char)(i * 37));
+    std::vector<unsigned char> u_expected = u;
+    std::sort(u_expected.begin(), u_expected.end());
+    fit::sort_by(u, identity_key());
+    FIT_TEST_CHECK(u == u_expected);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<std::unique_ptr<int>> v;
+    for(int i=0;i<300;i++) v.emplace_back(new int((i * 7) % 300));
+    fit::sort_by(v, ptr_key());
+    for(int i=0;i<300;i++) FIT_TEST_CHECK(*v[i] == i);
+}
@@ -9,10 +9,54 @@ fit::static_<void_class> void_static = {};
 
 fit::static_<mono_class> mono_static = {};
 
+static constexpr fit::static_<binary_class> binary_constexpr_static = {};
+
 
 FIT_TEST_CASE()
 {
     void_static(1);
     FIT_TEST_CHECK(3 == binary_static(1, 2));
     FIT_TEST_CHECK(3 == mono_static(2));
-}
\ No newline at end of file
+}
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(3 == binary_constexpr_static(1, 2));
+    FIT_TEST_CHECK(3 == binary_constexpr_static(1, 2));
+}
+
+struct runtime_constructed
+{
+    runtime_constructed()
+    {}
+
+    int operator()(int x) const
+    {
+        return x + 1;
+    }
+};
+
+struct nontrivial_destructor
+{
+    constexpr nontrivial_destructor()
+    {}
+
+    ~nontrivial_destructor()
+    {}
+
+    int operator()(int x) const
+    {
+        return x + 2;
+    }
+};
+
+static_assert(fit::detail::is_static_constexpr<binary_class>::value, "Not constexpr");
+static_assert(!fit::detail::is_static_constexpr<runtime_constructed>::value, "Constexpr");
+static_assert(!fit::detail::is_static_constexpr<nontrivial_destructor>::value, "Constexpr");
+
+FIT_TEST_CASE()
+{
+    fit::static_<runtime_constructed> f = {};
+    FIT_TEST_CHECK(f(1) == 2);
+    fit::static_<nontrivial_destructor> g = {};
+    FIT_TEST_CHECK(g(1) == 3);
+}
@@ -0,0 +1,113 @@
+#include <fit/thread_pool.h>
+#include <fit/capture.h>
+#include "test.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+FIT_TEST_CASE()
+{
+    std::atomic<int> n(0);
+    {
+        fit::thread_pool pool(2);
+        FIT_TEST_CHECK(pool.size() == 2);
+        for(int i=0;i<100;i++) pool.execute([&] { n++; });
+    }
+    FIT_TEST_CHECK(n == 100);
+}
+
+FIT_TEST_CASE()
+{
+    std::atomic<int> n(0);
+    {
+        fit::thread_pool pool(1);
+        std::unique_ptr<int> p(new int(3));
+        pool.execute(fit::capture(std::move(p))([&](const std::unique_ptr<int>& x) { n += *x; }));
+    }
+    FIT_TEST_CHECK(n == 3);
+}
+
+FIT_TEST_CASE()
+{
+    std::atomic<int> n(0);
+    auto id = std::this_thread::get_id();
+    std::atomic<bool> other_thread(false);
+    {
+        fit::thread_pool& pool = fit::default_thread_pool();
+        FIT_TEST_CHECK(&pool == &fit::default_thread_pool());
+        FIT_TEST_CHECK(pool.size() > 0);
+        std::mutex m;
+        std::condition_variable cv;
+        pool.execute([&] 
+        { 
+            other_thread = std::this_thread::get_id() != id; 
+            std::lock_guard<std::mutex> lock(m);
+            n++;
+            cv.notify_all();
+        });
+        std::unique_lock<std::mutex> lock(m);
+        cv.wait(lock, [&] { return n == 1; });
+    }
+    FIT_TEST_CHECK(other_thread);
+}
+
+FIT_TEST_CASE()
+{
+    std::atomic<int> n(0);
+    {
+        fit::work_stealing_pool pool(3);
+        FIT_TEST_CHECK(pool.size() == 3);
+        for(int i=0;i<100;i++) pool.execute([&] { n++; });
+    }
+    FIT_TEST_CHECK(n == 100);
+}
+
+// Tasks submitted from many threads at once are all run before shutdown
+FIT_TEST_CASE()
+{
+    std::atomic<int> n(0);
+    {
+        fit::work_stealing_pool pool(4);
+        std::vector<std::thread> submitters;
+        for(int t=0;t<8;t++) submitters.emplace_back([&]
+        {
+            for(int i=0;i<1000;i++) pool.execute([&] { n++; });
+        });
+        for(std::thread& t:submitters) t.join();
+    }
+    FIT_TEST_CHECK(n == 8000);
+}
+
+// Tasks submitted from a worker can be stolen by the other workers
+FIT_TEST_CASE()
+{
+    std::atomic<int> n(0);
+    std::mutex m;
+    std::condition_variable cv;
+    bool done = false;
+    {
+        fit::work_stealing_pool pool(2);
+        pool.execute([&]
+        {
+            pool.execute([&]
+            {
+                std::lock_guard<std::mutex> lock(m);
+                done = true;
+                cv.notify_all();
+            });
+            std::unique_lock<std::mutex> lock(m);
+            cv.wait(lock, [&] { return done; });
+            n++;
+        });
+    }
+    FIT_TEST_CHECK(n == 1);
+}
+
+FIT_TEST_CASE()
+{
+    fit::work_stealing_pool& pool = fit::default_work_stealing_pool();
+    FIT_TEST_CHECK(&pool == &fit::default_work_stealing_pool());
+    FIT_TEST_CHECK(pool.size() > 0);
+}
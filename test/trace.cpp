@@ -0,0 +1,135 @@
+#include <fit/trace.h>
+#include <fit/flow.h>
+#include "test.h"
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+static std::string dump()
+{
+    std::stringstream ss;
+    fit::trace_dump_json(ss);
+    return ss.str();
+}
+
+static int count(const std::string& s, const std::string& x)
+{
+    int n = 0;
+    for(std::size_t i = s.find(x); i != std::string::npos; i = s.find(x, i + x.size())) n++;
+    return n;
+}
+
+struct throws_f
+{
+    void operator()() const
+    {
+        throw std::runtime_error("error");
+    }
+};
+
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("binary", binary_class());
+    FIT_TEST_CHECK(f(1, 2) == 3);
+    std::string s = dump();
+    FIT_TEST_CHECK(s.find("{\"traceEvents\":[") == 0);
+    FIT_TEST_CHECK(count(s, "{\"name\":\"binary\",\"ph\":\"B\",") == 1);
+    FIT_TEST_CHECK(count(s, "{\"name\":\"binary\",\"ph\":\"E\",") == 1);
+    FIT_TEST_CHECK(s.find("\"ph\":\"B\"") < s.find("\"ph\":\"E\""));
+}
+
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("move", move_class());
+    FIT_TEST_CHECK(f(1, 2) == 3);
+    auto g = fit::trace("void", void_class());
+    g(1);
+    FIT_TEST_CHECK(count(dump(), "\"name\":\"void\"") == 2);
+}
+
+// Nested calls are recorded inside the calls that make them
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("outer", fit::flow(fit::trace("inner", unary_class()), unary_class()));
+    FIT_TEST_CHECK(f(3) == 3);
+    std::string s = dump();
+    FIT_TEST_CHECK(s.find("\"outer\",\"ph\":\"B\"") < s.find("\"inner\",\"ph\":\"B\""));
+    FIT_TEST_CHECK(s.find("\"inner\",\"ph\":\"E\"") < s.find("\"outer\",\"ph\":\"E\""));
+}
+
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("throws", throws_f());
+    bool caught = false;
+    try { f(); }
+    catch(const std::runtime_error&) { caught = true; }
+    FIT_TEST_CHECK(caught);
+    FIT_TEST_CHECK(count(dump(), "\"name\":\"throws\"") == 2);
+}
+
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("sampled", unary_class(), 10);
+    for(int i=0;i<100;i++) f(i);
+    FIT_TEST_CHECK(count(dump(), "\"name\":\"sampled\"") == 20);
+}
+
+// Each adaptor is sampled at its own rate, even when they are called
+// together
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::flow(
+        fit::trace("parse", unary_class()),
+        fit::trace("serialize", unary_class(), 100),
+        fit::trace("validate", unary_class(), 7)
+    );
+    for(int i=0;i<1000;i++) f(i);
+    std::string s = dump();
+    FIT_TEST_CHECK(count(s, "\"name\":\"parse\"") == 2000);
+    FIT_TEST_CHECK(count(s, "\"name\":\"serialize\"") == 20);
+    FIT_TEST_CHECK(count(s, "\"name\":\"validate\"") == 2 * (1000 / 7));
+}
+
+// Only the most recent events are kept
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("overflow", unary_class());
+    for(int i=0;i<FIT_TRACE_BUFFER_SIZE;i++) f(i);
+    FIT_TEST_CHECK(count(dump(), "\"name\":\"overflow\"") == FIT_TRACE_BUFFER_SIZE);
+}
+
+// Events can be written out while other threads are tracing, and each
+// thread has its own id
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("threads", unary_class());
+    std::vector<std::thread> threads;
+    for(int i=0;i<4;i++) threads.emplace_back([&] { for(int j=0;j<10000;j++) f(j); });
+    for(int i=0;i<10;i++) dump();
+    for(std::thread& t:threads) t.join();
+    std::string s = dump();
+    FIT_TEST_CHECK(count(s, "\"name\":\"threads\"") == 4 * FIT_TRACE_BUFFER_SIZE);
+    FIT_TEST_CHECK(count(s, "\"ph\":\"E\"") == count(s, "\"ph\":\"B\""));
+}
+
+FIT_TEST_CASE()
+{
+    fit::trace_clear();
+    auto f = fit::trace("dump \"quoted\"", unary_class());
+    f(1);
+    std::string s = dump();
+    FIT_TEST_CHECK(s.find("{\"name\":\"dump \\\"quoted\\\"\",\"ph\":\"B\",\"ts\":") != std::string::npos);
+    FIT_TEST_CHECK(s.find(",\"pid\":1,\"tid\":") != std::string::npos);
+    FIT_TEST_CHECK(s.back() == '}');
+}
@@ -0,0 +1,70 @@
+#include <fit/trampoline_fix.h>
+#include "test.h"
+
+#include <memory>
+
+struct sum_t
+{
+    template<class Self>
+    fit::trampoline_result<long long, long long, long long> operator()(Self self, long long acc, long long n) const
+    {
+        if (n == 0) return acc;
+        return self(acc + n, n - 1);
+    }
+};
+
+struct node
+{
+    int value;
+    std::unique_ptr<node> next;
+};
+
+struct list_sum_t
+{
+    template<class Self>
+    fit::trampoline_result<long long, const node*, long long> operator()(Self self, const node* n, long long acc) const
+    {
+        if (n == nullptr) return acc;
+        return self(n->next.get(), acc + n->value);
+    }
+};
+
+struct move_only_t
+{
+    std::unique_ptr<int> i;
+    move_only_t() : i(new int(2))
+    {}
+    template<class Self>
+    fit::trampoline_result<int, int> operator()(Self self, int x) const
+    {
+        if (x >= 100) return x;
+        return self(x * *i);
+    }
+};
+
+static constexpr fit::trampoline_fix_adaptor<sum_t> sum = {};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(sum(0LL, 10LL) == 55);
+    FIT_TEST_CHECK(sum(0, 10) == 55);
+    FIT_TEST_CHECK(fit::trampoline_fix(sum_t())(0LL, 1000000LL) == 500000500000LL);
+}
+
+FIT_TEST_CASE()
+{
+    std::unique_ptr<node> head;
+    for(int i=0;i<1000000;i++)
+    {
+        std::unique_ptr<node> n(new node{1, fit::move(head)});
+        head = fit::move(n);
+    }
+    FIT_TEST_CHECK(fit::trampoline_fix(list_sum_t())(static_cast<const node*>(head.get()), 0LL) == 1000000);
+    // Unlink iteratively to avoid recursive destruction
+    while(head) head = fit::move(head->next);
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::trampoline_fix(move_only_t())(3) == 192);
+}
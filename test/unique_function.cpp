@@ -0,0 +1,141 @@
+#include <fit/unique_function.h>
+#include <fit/compose.h>
+#include <fit/partial.h>
+#include "test.h"
+
+#include <array>
+
+static int allocations = 0;
+
+template<class T>
+struct counting_allocator
+{
+    typedef T value_type;
+    counting_allocator()
+    {}
+    template<class U>
+    counting_allocator(const counting_allocator<U>&)
+    {}
+    T* allocate(std::size_t n)
+    {
+        allocations++;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n)
+    {
+        allocations--;
+        std::allocator<T>().deallocate(p, n);
+    }
+    template<class U>
+    bool operator==(const counting_allocator<U>&) const
+    {
+        return true;
+    }
+    template<class U>
+    bool operator!=(const counting_allocator<U>&) const
+    {
+        return false;
+    }
+};
+
+struct add_unique
+{
+    std::unique_ptr<int> i;
+    int operator()(int x) const
+    {
+        return *i + x;
+    }
+};
+
+static add_unique make_add_unique(int i)
+{
+    return add_unique{std::unique_ptr<int>(new int(i))};
+}
+
+struct big_function
+{
+    std::array<int, 16> data;
+    int operator()(int x) const
+    {
+        return data[0] + x;
+    }
+};
+
+STATIC_ASSERT_MOVE_ONLY(fit::unique_function<int(int)>);
+static_assert(fit::is_inline_storable<mono_class>::value, "Not inline");
+static_assert(fit::is_inline_storable<add_unique>::value, "Not inline");
+static_assert(!fit::is_inline_storable<big_function>::value, "Inline");
+static_assert(fit::is_inline_storable<big_function, sizeof(big_function)>::value, "Not inline");
+static_assert(fit::unique_function<int(int), sizeof(big_function)>::stores_inline<big_function>::value, "Not inline");
+
+FIT_TEST_CASE()
+{
+    fit::unique_function<int(int)> f = mono_class();
+    FIT_TEST_CHECK(f);
+    FIT_TEST_CHECK(f(1) == 2);
+    f = fit::compose(mono_class(), mono_class());
+    FIT_TEST_CHECK(f(1) == 3);
+    f = fit::partial(binary_class())(2);
+    FIT_TEST_CHECK(f(1) == 3);
+    f = nullptr;
+    FIT_TEST_CHECK(!f);
+}
+
+FIT_TEST_CASE()
+{
+    typedef fit::unique_function<int(int), 3*sizeof(void*), counting_allocator<char>> function;
+    allocations = 0;
+    {
+        function f = make_add_unique(1);
+        FIT_TEST_CHECK(allocations == 0);
+        FIT_TEST_CHECK(f(2) == 3);
+        function g = fit::move(f);
+        FIT_TEST_CHECK(!f);
+        FIT_TEST_CHECK(g(2) == 3);
+    }
+    FIT_TEST_CHECK(allocations == 0);
+}
+
+FIT_TEST_CASE()
+{
+    typedef fit::unique_function<int(int), 3*sizeof(void*), counting_allocator<char>> function;
+    allocations = 0;
+    {
+        big_function b = {};
+        b.data[0] = 5;
+        function f = b;
+        FIT_TEST_CHECK(allocations == 1);
+        FIT_TEST_CHECK(f(1) == 6);
+        function g = fit::move(f);
+        FIT_TEST_CHECK(allocations == 1);
+        FIT_TEST_CHECK(g(1) == 6);
+        g = mono_class();
+        FIT_TEST_CHECK(allocations == 0);
+        FIT_TEST_CHECK(g(1) == 2);
+    }
+    FIT_TEST_CHECK(allocations == 0);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<fit::unique_function<int(int)>> callbacks;
+    for(int i=0;i<100;i++) callbacks.push_back(make_add_unique(i));
+    int sum = 0;
+    for(auto&& f:callbacks) sum += f(0);
+    FIT_TEST_CHECK(sum == 4950);
+}
+
+FIT_TEST_CASE()
+{
+    fit::unique_function<void(int)> f;
+    bool thrown = false;
+    try
+    {
+        f(1);
+    }
+    catch(const std::bad_function_call&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+}
@@ -3,7 +3,9 @@
 #include <fit/lambda.h>
 #include "test.h"
 
+#include <array>
 #include <memory>
+#include <utility>
 
 fit::static_<fit::unpack_adaptor<unary_class> > unary_unpack = {};
 fit::static_<fit::unpack_adaptor<binary_class> > binary_unpack = {};
@@ -97,6 +99,10 @@ FIT_TEST_CASE()
     static_assert(fit::is_unpackable<decltype(p3)>::value, "Not unpackable");
     static_assert(fit::is_unpackable<decltype((p3))>::value, "Not unpackable");
 
+    auto p4 = fit::pack_packed(1, 2);
+    static_assert(fit::is_unpackable<decltype(p4)>::value, "Not unpackable");
+    static_assert(fit::is_unpackable<decltype((p4))>::value, "Not unpackable");
+
     static_assert(fit::is_unpackable<std::tuple<int>>::value, "Not unpackable");
     
     static_assert(!fit::is_unpackable<int>::value, "Unpackable");
@@ -160,6 +166,7 @@ FIT_TEST_CASE()
     FIT_TEST_CHECK(3 == fit::unpack(indirect_sum_f())(fit::pack(MAKE_UNIQUE_PTR(1), MAKE_UNIQUE_PTR(2))));
     FIT_TEST_CHECK(3 == fit::unpack(indirect_sum_f())(fit::pack_forward(MAKE_UNIQUE_PTR(1), MAKE_UNIQUE_PTR(2))));
     FIT_TEST_CHECK(3 == fit::unpack(indirect_sum_f())(fit::pack_decay(MAKE_UNIQUE_PTR(1), MAKE_UNIQUE_PTR(2))));
+    FIT_TEST_CHECK(3 == fit::unpack(indirect_sum_f())(fit::pack_packed(MAKE_UNIQUE_PTR(1), MAKE_UNIQUE_PTR(2))));
     FIT_TEST_CHECK(3 == fit::unpack(indirect_sum_f())(std::make_tuple(MAKE_UNIQUE_PTR(1), MAKE_UNIQUE_PTR(2))));
 }
 
@@ -187,7 +194,116 @@ FIT_TEST_CASE()
 
 
     STATIC_ASSERT_SAME(deduce_types<int, int>, decltype(deduce(fit::pack(1, 2))));
+    STATIC_ASSERT_SAME(deduce_types<char, double>, decltype(deduce(fit::pack_packed('a', 1.5))));
     STATIC_ASSERT_SAME(deduce_types<int, int>, decltype(deduce(fit::pack(1), fit::pack(2))));
     STATIC_ASSERT_SAME(deduce_types<int, int, int>, decltype(deduce(fit::pack(1), fit::pack(2), fit::pack(3))));
     // STATIC_ASSERT_SAME(deduce_types<int&&, int&&>, decltype(deduce(fit::pack_forward(1, 2))));
 }
+
+struct copy_counter
+{
+    static int copies;
+    static int moves;
+    int value;
+    copy_counter(int x) : value(x)
+    {}
+    copy_counter(const copy_counter& rhs) : value(rhs.value)
+    {
+        copies++;
+    }
+    copy_counter(copy_counter&& rhs) : value(rhs.value)
+    {
+        moves++;
+    }
+    static void reset()
+    {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+int copy_counter::copies = 0;
+int copy_counter::moves = 0;
+
+struct counter_sum_f
+{
+    template<class... Ts>
+    int operator()(Ts&&... xs) const
+    {
+        int result = 0;
+        for(int x:{xs.value...}) result += x;
+        return result;
+    }
+};
+
+namespace unpack_test {
+
+struct point
+{
+    copy_counter x;
+    copy_counter y;
+};
+
+template<std::size_t N>
+const copy_counter& get(const point& p)
+{
+    return N == 0 ? p.x : p.y;
+}
+
+}
+
+namespace std {
+
+template<>
+struct tuple_size<unpack_test::point>
+: std::integral_constant<std::size_t, 2>
+{};
+
+}
+
+FIT_TEST_CASE()
+{
+    static_assert(fit::is_unpackable<std::array<int, 3>>::value, "Not unpackable");
+    static_assert(fit::is_unpackable<std::pair<int, int>>::value, "Not unpackable");
+    static_assert(fit::is_unpackable<int[3]>::value, "Not unpackable");
+    static_assert(fit::is_unpackable<const int(&)[3]>::value, "Not unpackable");
+    static_assert(fit::is_unpackable<unpack_test::point>::value, "Not unpackable");
+
+    FIT_TEST_CHECK(3 == binary_unpack(std::array<int, 2>{{1, 2}}));
+    FIT_TEST_CHECK(3 == binary_unpack(std::make_pair(1, 2)));
+    FIT_TEST_CHECK(3 == binary_unpack(std::array<int, 1>{{1}}, std::array<int, 0>(), std::array<int, 1>{{2}}));
+    int a[] = {1, 2};
+    FIT_TEST_CHECK(3 == binary_unpack(a));
+
+    FIT_STATIC_TEST_CHECK(3 == binary_unpack_constexpr(std::make_pair(1, 2)));
+}
+
+FIT_TEST_CASE()
+{
+    STATIC_ASSERT_SAME(deduce_types<int&, int&>, decltype(deduce(std::declval<std::array<int, 2>&>())));
+    STATIC_ASSERT_SAME(deduce_types<int, int>, decltype(deduce(std::declval<std::array<int, 2>>())));
+    STATIC_ASSERT_SAME(deduce_types<int&, long&>, decltype(deduce(std::declval<std::pair<int, long>&>())));
+    STATIC_ASSERT_SAME(deduce_types<const int&, const int&>, decltype(deduce(std::declval<const int(&)[2]>())));
+    STATIC_ASSERT_SAME(deduce_types<int, int>, decltype(deduce(std::declval<int(&&)[2]>())));
+}
+
+FIT_TEST_CASE()
+{
+    std::array<copy_counter, 3> a = {{1, 2, 3}};
+    std::pair<copy_counter, copy_counter> p(1, 2);
+    copy_counter c[] = {1, 2, 3};
+    unpack_test::point pt = {1, 2};
+    copy_counter::reset();
+
+    FIT_TEST_CHECK(6 == fit::unpack(counter_sum_f())(a));
+    FIT_TEST_CHECK(3 == fit::unpack(counter_sum_f())(p));
+    FIT_TEST_CHECK(6 == fit::unpack(counter_sum_f())(c));
+    FIT_TEST_CHECK(3 == fit::unpack(counter_sum_f())(pt));
+    FIT_TEST_CHECK(12 == fit::unpack(counter_sum_f())(a, p, pt));
+    FIT_TEST_CHECK(6 == fit::unpack(counter_sum_f())(fit::move(a)));
+    FIT_TEST_CHECK(3 == fit::unpack(counter_sum_f())(fit::move(p)));
+    FIT_TEST_CHECK(6 == fit::unpack(counter_sum_f())(fit::move(c)));
+
+    FIT_TEST_CHECK(copy_counter::copies == 0);
+    FIT_TEST_CHECK(copy_counter::moves == 0);
+}
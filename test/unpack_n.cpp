@@ -0,0 +1,120 @@
+#include <fit/unpack_n.h>
+#include "test.h"
+
+#include <string>
+#include <vector>
+
+struct sum_n
+{
+    template<class... Ts>
+    int operator()(Ts... xs) const
+    {
+        int result = 0;
+        for(int x:{0, xs...}) result += x;
+        return result;
+    }
+};
+
+struct count_f
+{
+    template<class... Ts>
+    std::size_t operator()(Ts&&...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+
+struct size_fallback
+{
+    template<class S>
+    int operator()(const S& s) const
+    {
+        return -int(s.size());
+    }
+};
+
+struct assign_f
+{
+    template<class... Ts>
+    void operator()(Ts&... xs) const
+    {
+        int i = 0;
+        for(int* p:{static_cast<int*>(nullptr), &xs...}) if (p != nullptr) *p = ++i;
+    }
+};
+
+struct size_string_fallback
+{
+    template<class S>
+    std::string operator()(const S& s) const
+    {
+        return std::to_string(s.size());
+    }
+};
+
+struct concat_f
+{
+    std::string operator()(const std::string& x, const std::string& y) const
+    {
+        return x + y;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v;
+    auto f = fit::unpack_n<8>(sum_n());
+    FIT_TEST_CHECK(f(v) == 0);
+    for(int i=1;i<=8;i++)
+    {
+        v.push_back(i);
+        FIT_TEST_CHECK(f(v) == i*(i+1)/2);
+    }
+    v.push_back(9);
+    bool thrown = false;
+    try
+    {
+        f(v);
+    }
+    catch(const std::length_error&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v(5);
+    FIT_TEST_CHECK(fit::unpack_n<3>(sum_n(), size_fallback())(v) == -5);
+    FIT_TEST_CHECK(fit::unpack_n<5>(count_f())(v) == 5);
+    FIT_TEST_CHECK(fit::unpack_n<5>(count_f())(std::vector<int>()) == 0);
+    STATIC_ASSERT_SAME(decltype(fit::unpack_n<5>(count_f())(v)), std::size_t);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v(4);
+    fit::unpack_n<4>(assign_f())(v);
+    FIT_TEST_CHECK(v == (std::vector<int>{1, 2, 3, 4}));
+}
+
+FIT_TEST_CASE()
+{
+    // Lengths that the function can't be called with use the fallback
+    auto f = fit::unpack_n<4>(concat_f(), size_string_fallback());
+    std::vector<std::string> v = {"a", "b"};
+    FIT_TEST_CHECK(f(v) == "ab");
+    v.push_back("c");
+    FIT_TEST_CHECK(f(v) == "3");
+    bool thrown = false;
+    try
+    {
+        fit::unpack_n<4>(concat_f())(v);
+    }
+    catch(const std::length_error&)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+}
@@ -0,0 +1,149 @@
+#include <fit/vectorize.h>
+#include <fit/placeholders.h>
+#include <fit/by.h>
+#include "test.h"
+
+#include <array>
+#include <vector>
+
+struct abs_f
+{
+    template<class T>
+    auto operator()(T x) const FIT_RETURNS(x < 0 ? -x : x);
+};
+
+struct max_f
+{
+    template<class T>
+    T operator()(T x, T y) const
+    {
+        return x > y ? x : y;
+    }
+};
+
+struct scalar_only
+{
+    float operator()(float x) const
+    {
+        return x + 1;
+    }
+};
+
+struct batch_counter
+{
+    static int batches;
+    static int scalars;
+
+    float operator()(float x) const
+    {
+        scalars++;
+        return x * 2;
+    }
+
+    fit::simd<float>::type operator()(fit::simd<float>::type x) const
+    {
+        batches++;
+        return x * 2;
+    }
+};
+
+int batch_counter::batches = 0;
+int batch_counter::scalars = 0;
+
+struct greater_f
+{
+    template<class T>
+    auto operator()(T x, T y) const FIT_RETURNS(x > y);
+};
+
+struct greater_or_equal_f
+{
+    template<class T>
+    auto operator()(T x, T y) const FIT_RETURNS(!(x < y));
+};
+
+static_assert(fit::simd<char>::lanes == FIT_SIMD_BYTES, "Wrong number of lanes");
+static_assert(fit::simd<bool>::lanes == 1, "Wrong number of lanes");
+
+FIT_TEST_CASE()
+{
+    std::vector<float> x, y, z, out(37);
+    for(int i=0;i<37;i++)
+    {
+        x.push_back(i);
+        y.push_back(i % 5);
+        z.push_back(1);
+    }
+    fit::vectorize(fit::_1 * fit::_2 + fit::_3)(out, x, y, z);
+    for(int i=0;i<37;i++) FIT_TEST_CHECK(out[i] == x[i] * y[i] + z[i]);
+}
+
+FIT_TEST_CASE()
+{
+    std::array<int, 19> x, y;
+    std::array<int, 19> out;
+    for(int i=0;i<19;i++)
+    {
+        x[i] = (i % 2 == 0) ? -i : i;
+        y[i] = 9;
+    }
+    fit::vectorize(fit::by(abs_f(), max_f()))(out, x, y);
+    for(int i=0;i<19;i++) FIT_TEST_CHECK(out[i] == (i > 9 ? i : 9));
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<float> x(10, 1.0f), out(10);
+    fit::vectorize(scalar_only())(out, x);
+    for(float r:out) FIT_TEST_CHECK(r == 2.0f);
+}
+
+FIT_TEST_CASE()
+{
+    // Mixed element types fall back to scalar
+    std::vector<float> x(9, 2.0f), out(9);
+    std::vector<double> y(9, 3.0);
+    fit::vectorize(fit::_1 * fit::_2)(out, x, y);
+    for(float r:out) FIT_TEST_CHECK(r == 6.0f);
+}
+
+FIT_TEST_CASE()
+{
+    const std::size_t lanes = fit::simd<float>::lanes;
+    std::vector<float> x(3*lanes + 1, 1.0f), out(3*lanes + 1);
+    fit::vectorize(batch_counter())(out, x);
+    for(float r:out) FIT_TEST_CHECK(r == 2.0f);
+#if FIT_HAS_VECTOR_EXTENSIONS
+    FIT_TEST_CHECK(batch_counter::batches == 3);
+    FIT_TEST_CHECK(batch_counter::scalars == 1);
+#else
+    FIT_TEST_CHECK(batch_counter::scalars == 3*lanes + 1);
+#endif
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> x(20, 1), out(10, 0);
+    fit::vectorize(fit::_1 + 1)(out, x);
+    for(int r:out) FIT_TEST_CHECK(r == 2);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> x = {1, 5, 3, 7, 2, 8, 0, 9, 4}, y(9, 4), out(9);
+    fit::vectorize(fit::_1 > fit::_2)(out, x, y);
+    for(int i=0;i<9;i++) FIT_TEST_CHECK(out[i] == (x[i] > y[i] ? 1 : 0));
+    fit::vectorize((fit::_1 > fit::_2) + fit::_1)(out, x, y);
+    for(int i=0;i<9;i++) FIT_TEST_CHECK(out[i] == (x[i] > y[i] ? 1 : 0) + x[i]);
+}
+
+// Comparisons in functions other than placeholder expressions aren't
+// vectorized either
+FIT_TEST_CASE()
+{
+    std::vector<int> x = {1, 5, 3, 7, 2, 8, 0, 9, 4}, y(9, 4), out(9);
+    fit::vectorize(greater_f())(out, x, y);
+    for(int i=0;i<9;i++) FIT_TEST_CHECK(out[i] == (x[i] > y[i] ? 1 : 0));
+    fit::vectorize(greater_or_equal_f())(out, x, y);
+    for(int i=0;i<9;i++) FIT_TEST_CHECK(out[i] == (x[i] >= y[i] ? 1 : 0));
+}
@@ -0,0 +1,96 @@
+#include <fit/visit.h>
+#include "test.h"
+
+#if FIT_HAS_VARIANT
+#include <fit/detail/seq.h>
+#include <string>
+
+struct index_f
+{
+    template<class T>
+    int operator()(const T&) const
+    {
+        return sizeof(T);
+    }
+};
+
+struct sum_f
+{
+    template<class T, class U>
+    constexpr double operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+template<int N>
+struct tag
+{};
+
+struct tag_f
+{
+    template<int N>
+    constexpr int operator()(tag<N>) const
+    {
+        return N;
+    }
+};
+
+template<int... Ns>
+std::variant<tag<Ns>...> make_tag_variant(int n, fit::detail::seq<Ns...>)
+{
+    std::variant<tag<Ns>...> result;
+    int i = 0;
+    (void)std::initializer_list<int>{(i++ == n ? (result = tag<Ns>(), 0) : 0)...};
+    return result;
+}
+
+FIT_TEST_CASE()
+{
+    std::variant<int, std::string> v = std::string("hello");
+    auto f = [](const std::string& s) { return int(s.size()); };
+    auto g = [](int x) { return x; };
+    FIT_TEST_CHECK(fit::visit_match(v, g, f) == 5);
+    v = 3;
+    FIT_TEST_CHECK(fit::visit_match(v, g, f) == 3);
+    FIT_TEST_CHECK(fit::visit(index_f())(v) == sizeof(int));
+}
+
+FIT_TEST_CASE()
+{
+    std::variant<int, double> x = 1;
+    std::variant<char, int, double> y = 2.5;
+    FIT_TEST_CHECK(fit::visit(sum_f())(x, y) == 3.5);
+    x = 0.5;
+    y = char(1);
+    FIT_TEST_CHECK(fit::visit(sum_f())(x, y) == 1.5);
+    y = 4;
+    FIT_TEST_CHECK(fit::visit(sum_f())(x, y) == 4.5);
+    FIT_TEST_CHECK(fit::visit(sum_f())(y, x) == 4.5);
+}
+
+FIT_TEST_CASE()
+{
+    auto v = make_tag_variant(23, fit::detail::gens<32>::type());
+    FIT_TEST_CHECK(v.index() == 23);
+    FIT_TEST_CHECK(fit::visit(tag_f())(v) == 23);
+    for(int i=0;i<32;i++) FIT_TEST_CHECK(fit::visit(tag_f())(make_tag_variant(i, fit::detail::gens<32>::type())) == i);
+}
+
+FIT_TEST_CASE()
+{
+    std::variant<std::unique_ptr<int>, int> v = std::unique_ptr<int>(new int(2));
+    auto r = fit::visit_match(fit::move(v), 
+        [](std::unique_ptr<int> p) { return *p; }, 
+        [](int x) { return x; }
+    );
+    FIT_TEST_CHECK(r == 2);
+}
+
+FIT_TEST_CASE()
+{
+    constexpr std::variant<int, double> x = 2;
+    constexpr std::variant<int, double> y = 1.5;
+    FIT_STATIC_TEST_CHECK(fit::visit(sum_f())(x, y) == 3.5);
+}
+#endif